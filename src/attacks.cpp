@@ -0,0 +1,201 @@
+#include <array>
+#include <stddef.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "attacks.hpp"
+#include "bitboard.hpp"
+
+std::array<Magic, 64> bishopMagics;
+std::array<Magic, 64> rookMagics;
+
+static const std::vector<std::pair<int, int>> diagonalOffsets = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+static const std::vector<std::pair<int, int>> orthogonalOffsets = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+std::array<std::array<Bitboard, 64>, 64> betweenTable;
+std::array<std::array<Bitboard, 64>, 64> lineTable;
+
+static std::array<Bitboard, 0x1480> bishopTable; // sum over squares of 2^(relevant bishop blockers)
+static std::array<Bitboard, 0x19000> rookTable;  // sum over squares of 2^(relevant rook blockers)
+
+Bitboard slidingAttacks(const int index, const std::vector<std::pair<int, int>> &offsets, const Bitboard occupied)
+{
+  Bitboard res = 0;
+
+  for (auto &offset : offsets)
+  {
+    // walk the ray until it leaves the board or hits a piece (the blocker itself is attacked)
+    Bitboard ray = shiftBitboard(squareBitboard(index), offset.first, offset.second);
+    while (ray)
+    {
+      res |= ray;
+      if (ray & occupied)
+      {
+        break;
+      }
+      ray = shiftBitboard(ray, offset.first, offset.second);
+    }
+  }
+
+  return res;
+}
+
+// Magic numbers for this board orientation (bit 0 = a8), found offline with a sparse-random
+// trial search. Each one maps every blocker subset of its mask into 2^popCount(mask) slots
+// without two different attack sets colliding.
+static const std::array<Bitboard, 64> bishopMagicNumbers = {
+    0x2008021012002502ULL, 0x04D0100110628400ULL, 0x21102080A1021010ULL, 0x2044041080000400ULL,
+    0x0004050402800000ULL, 0x0002010420109560ULL, 0x08040084500A0000ULL, 0x9401002104224008ULL,
+    0x40044350070B0100ULL, 0x90B00888088C1040ULL, 0x0100100440444012ULL, 0x80001104008A0940ULL,
+    0x1042920210504048ULL, 0x0000010420048200ULL, 0x000000A410221000ULL, 0x804800829C901001ULL,
+    0x0040002008010120ULL, 0x8802008424280205ULL, 0x200800010A040010ULL, 0x2420800802004008ULL,
+    0x0012011402A21220ULL, 0x2002028508022208ULL, 0x0486200049100802ULL, 0x2000211101080200ULL,
+    0x8020200044140C60ULL, 0x0810680C05080381ULL, 0x0001442028012400ULL, 0x4028088008020002ULL,
+    0x25C1001041004010ULL, 0x0401020049080140ULL, 0x0004004084210400ULL, 0x40010900104400A0ULL,
+    0x011011480004A800ULL, 0x0082020200A0680BULL, 0x0800203000080082ULL, 0x0005020081880080ULL,
+    0x1050120080001004ULL, 0x0020008880030810ULL, 0x2241180900008C30ULL, 0x0201451101012400ULL,
+    0x8444016008025000ULL, 0x0002080104000800ULL, 0x2801001490090200ULL, 0x0500142018001100ULL,
+    0x0300040408200400ULL, 0x0008008800820810ULL, 0x0804210204004212ULL, 0x000800A698800202ULL,
+    0x0411040202401000ULL, 0x0A008C051802000EULL, 0x1002A100A8040022ULL, 0x00000C0084042600ULL,
+    0x1000884048220000ULL, 0x0082200410208000ULL, 0x0222020441140022ULL, 0x1004080800408810ULL,
+    0x0022410801500201ULL, 0x010000410818020BULL, 0x2044000044040410ULL, 0x00200C0100208801ULL,
+    0x080800200A102400ULL, 0x000404C010020090ULL, 0x1002101418808C03ULL, 0x0011300081040020ULL};
+
+static const std::array<Bitboard, 64> rookMagicNumbers = {
+    0x0080068051E04000ULL, 0x0040001000402000ULL, 0x0080100020008008ULL, 0x4E000A0010208440ULL,
+    0x4200040802002010ULL, 0x0100010008020400ULL, 0x9080608019000600ULL, 0x8100020080204100ULL,
+    0x4103800480400020ULL, 0x8015004004802100ULL, 0x000200108A002040ULL, 0x0801000821001000ULL,
+    0x0015000500080070ULL, 0x0120800400800200ULL, 0x0109000432001100ULL, 0x020080055B000080ULL,
+    0x0080004000402002ULL, 0x5260848020004008ULL, 0x2402020014402080ULL, 0x3000808010000802ULL,
+    0x0304018004810800ULL, 0x0000808004000200ULL, 0x0002040001500248ULL, 0x0012020000408401ULL,
+    0x8440008080004020ULL, 0x0804200840100040ULL, 0x0820008080201000ULL, 0x2080100100082100ULL,
+    0x0001000500100800ULL, 0x00A1000900028400ULL, 0x0100100400C80102ULL, 0x000001120000A044ULL,
+    0x800080C004800620ULL, 0x4040081000202000ULL, 0x0D08802008801000ULL, 0x1000800800801004ULL,
+    0x1004000801010010ULL, 0x0402800400800200ULL, 0x0004080204008110ULL, 0x0000404082000401ULL,
+    0x00C0118861408000ULL, 0x1100220081020048ULL, 0x09A0430420050010ULL, 0x0000082200420010ULL,
+    0x2110080004008080ULL, 0x2004201040680104ULL, 0x1106001451820008ULL, 0x0002224104820014ULL,
+    0x00800C8044210500ULL, 0x02A0200040100040ULL, 0x040100A0001E4100ULL, 0x00204023108A0200ULL,
+    0x2400080080040080ULL, 0x1289008400020900ULL, 0x0002088250010400ULL, 0x0001006084010200ULL,
+    0x0001023480002141ULL, 0x0006400021810015ULL, 0x8400100840200101ULL, 0x40003000A1000825ULL,
+    0x1002011008200402ULL, 0x100D000400080201ULL, 0x0020048806102904ULL, 0x8401000020804201ULL};
+
+static void initMagics(
+    std::array<Magic, 64> &magics,
+    const std::array<Bitboard, 64> &magicNumbers,
+    Bitboard *table,
+    const size_t tableSize,
+    const std::vector<std::pair<int, int>> &offsets)
+{
+  size_t offset = 0;
+
+  for (int index = 0; index < 64; ++index)
+  {
+    // blockers on the board edge never change the attack set, so leave them out of the mask
+    const int file = index % 8;
+    const int row = index / 8;
+    const Bitboard edges = ((rank8Bitboard | rank1Bitboard) & ~(rank8Bitboard << (8 * row))) |
+                           ((fileABitboard | fileHBitboard) & ~(fileABitboard << file));
+
+    auto &m = magics[index];
+    m.mask = slidingAttacks(index, offsets, 0) & ~edges;
+    m.magic = magicNumbers[index];
+    m.shift = 64 - popCount(m.mask);
+    m.attacks = table + offset;
+
+    const size_t size = size_t{1} << popCount(m.mask);
+    if (offset + size > tableSize)
+    {
+      throw std::logic_error("initMagics(): attack table is too small");
+    }
+
+    // enumerate every subset of the mask (carry-rippler) and store its attack set
+    Bitboard *attacks = table + offset;
+    Bitboard b = 0;
+    do
+    {
+      attacks[m.index(b)] = slidingAttacks(index, offsets, b);
+      b = (b - m.mask) & m.mask;
+    } while (b);
+
+    offset += size;
+  }
+}
+
+Bitboard attackedSquares(const PieceColor attackerColor, const Bitboards &bitboards)
+{
+  const auto attackers = [&](const PieceType type) { return bitboards.pieceBitboard(attackerColor, type); };
+  const Bitboard occupied = bitboards.occupied & ~bitboards.pieceBitboard(!attackerColor, PieceType::King);
+  const int pawnRankOffset = attackerColor == PieceColor::White ? 1 : -1;
+
+  const Bitboard pawns = attackers(PieceType::Pawn);
+  Bitboard res = shiftBitboard(pawns, 1, pawnRankOffset) | shiftBitboard(pawns, -1, pawnRankOffset);
+
+  Bitboard knights = attackers(PieceType::Knight);
+  while (knights)
+  {
+    res |= knightAttacks(popLsb(knights));
+  }
+
+  const Bitboard queens = attackers(PieceType::Queen);
+  Bitboard diagonalSliders = attackers(PieceType::Bishop) | queens;
+  while (diagonalSliders)
+  {
+    res |= bishopAttacks(popLsb(diagonalSliders), occupied);
+  }
+
+  Bitboard orthogonalSliders = attackers(PieceType::Rook) | queens;
+  while (orthogonalSliders)
+  {
+    res |= rookAttacks(popLsb(orthogonalSliders), occupied);
+  }
+
+  Bitboard kings = attackers(PieceType::King);
+  while (kings)
+  {
+    res |= kingAttacks(popLsb(kings));
+  }
+
+  return res;
+}
+
+static void initLineTables()
+{
+  static const std::array<std::pair<int, int>, 8> directions = {
+      {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+  for (int from = 0; from < 64; ++from)
+  {
+    for (const auto &[fileOffset, rankOffset] : directions)
+    {
+      const Bitboard line = slidingAttacks(from, {{fileOffset, rankOffset}, {-fileOffset, -rankOffset}}, 0) |
+                            squareBitboard(from);
+
+      Bitboard between = 0;
+      Bitboard ray = shiftBitboard(squareBitboard(from), fileOffset, rankOffset);
+      while (ray)
+      {
+        const int to = lsbIndex(ray);
+        betweenTable[from][to] = between;
+        lineTable[from][to] = line;
+        between |= ray;
+        ray = shiftBitboard(ray, fileOffset, rankOffset);
+      }
+    }
+  }
+}
+
+static const bool attackTablesInitialized = []()
+{
+#ifdef USE_PEXT
+  __builtin_cpu_init(); // may run before the runtime's own CPU detection
+  if (!__builtin_cpu_supports("bmi2"))
+  {
+    throw std::runtime_error("built with USE_PEXT, but the CPU does not support BMI2");
+  }
+#endif
+  initMagics(bishopMagics, bishopMagicNumbers, bishopTable.data(), bishopTable.size(), diagonalOffsets);
+  initMagics(rookMagics, rookMagicNumbers, rookTable.data(), rookTable.size(), orthogonalOffsets);
+  initLineTables();
+  return true;
+}();
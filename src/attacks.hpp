@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+#include "bitboard.hpp"
+
+// Slider attacks use magic bitboards: the relevant blockers for a square are multiplied by a
+// per-square magic number so that the top bits form a perfect hash into a precomputed table.
+// Builds configured with USE_PEXT (BMI2 required) index the same tables with PEXT instead, which
+// extracts the blocker bits directly. The backend is fixed at compile time so every lookup inlines
+// without a dispatch branch. The tables are filled once during static initialization (see
+// attacks.cpp), so nothing may look up slider attacks from another static initializer.
+
+#ifdef USE_PEXT
+#include <immintrin.h>
+#endif
+
+struct Magic
+{
+  Bitboard mask;
+  Bitboard magic;
+  const Bitboard *attacks;
+  unsigned shift;
+
+  size_t index(const Bitboard occupied) const
+  {
+#ifdef USE_PEXT
+    return _pext_u64(occupied, mask);
+#else
+    return ((occupied & mask) * magic) >> shift;
+#endif
+  }
+};
+
+extern std::array<Magic, 64> bishopMagics;
+extern std::array<Magic, 64> rookMagics;
+
+inline Bitboard bishopAttacks(const int index, const Bitboard occupied)
+{
+  const auto &m = bishopMagics[index];
+  return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard rookAttacks(const int index, const Bitboard occupied)
+{
+  const auto &m = rookMagics[index];
+  return m.attacks[m.index(occupied)];
+}
+
+// Knight, king and pawn attacks do not depend on blockers, so they are plain 64-entry tables
+// generated at compile time.
+
+template <size_t N>
+constexpr std::array<Bitboard, 64> makeStepAttackTable(const std::array<std::pair<int, int>, N> &offsets)
+{
+  std::array<Bitboard, 64> res{};
+  for (int index = 0; index < 64; ++index)
+  {
+    for (const auto &offset : offsets)
+    {
+      res[index] |= shiftBitboard(squareBitboard(index), offset.first, offset.second);
+    }
+  }
+
+  return res;
+}
+
+inline constexpr std::array<std::pair<int, int>, 8> knightOffsets = {
+    {{1, 2}, {1, -2}, {-1, 2}, {-1, -2}, {2, 1}, {2, -1}, {-2, 1}, {-2, -1}}};
+inline constexpr std::array<std::pair<int, int>, 8> kingOffsets = {
+    {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+inline constexpr std::array<std::pair<int, int>, 2> whitePawnCaptureOffsets = {{{1, 1}, {-1, 1}}};
+inline constexpr std::array<std::pair<int, int>, 2> blackPawnCaptureOffsets = {{{1, -1}, {-1, -1}}};
+
+inline constexpr std::array<Bitboard, 64> knightAttackTable = makeStepAttackTable(knightOffsets);
+inline constexpr std::array<Bitboard, 64> kingAttackTable = makeStepAttackTable(kingOffsets);
+inline constexpr std::array<std::array<Bitboard, 64>, 2> pawnAttackTable = {
+    makeStepAttackTable(whitePawnCaptureOffsets),
+    makeStepAttackTable(blackPawnCaptureOffsets)};
+
+static_assert(knightAttackTable[0] == (squareBitboard(10) | squareBitboard(17)), "knight on a8 attacks c7 and b6");
+static_assert(
+    kingAttackTable[63] == (squareBitboard(54) | squareBitboard(55) | squareBitboard(62)),
+    "king on h1 attacks g2, h2 and g1");
+static_assert(
+    pawnAttackTable[0][52] == (squareBitboard(43) | squareBitboard(45)),
+    "white pawn on e2 attacks d3 and f3");
+
+inline Bitboard knightAttacks(const int index) { return knightAttackTable[index]; }
+
+inline Bitboard kingAttacks(const int index) { return kingAttackTable[index]; }
+
+// squares attacked by a pawn of the given color standing on index
+inline Bitboard pawnAttacks(const PieceColor color, const int index)
+{
+  return pawnAttackTable[colorIndex(color)][index];
+}
+
+inline Bitboard queenAttacks(const int index, const Bitboard occupied)
+{
+  return bishopAttacks(index, occupied) | rookAttacks(index, occupied);
+}
+
+// attacks of a non-pawn piece type, resolved at compile time
+template <PieceType Type>
+inline Bitboard pieceAttacks(const int index, [[maybe_unused]] const Bitboard occupied)
+{
+  static_assert(Type != PieceType::Pawn, "pawn attacks depend on color, use pawnAttacks()");
+
+  if constexpr (Type == PieceType::Knight)
+  {
+    return knightAttacks(index);
+  }
+  else if constexpr (Type == PieceType::Bishop)
+  {
+    return bishopAttacks(index, occupied);
+  }
+  else if constexpr (Type == PieceType::Rook)
+  {
+    return rookAttacks(index, occupied);
+  }
+  else if constexpr (Type == PieceType::Queen)
+  {
+    return queenAttacks(index, occupied);
+  }
+  else
+  {
+    return kingAttacks(index);
+  }
+}
+
+// every square attacked by the attacker's pieces, with the defending king treated as transparent so
+// that squares behind it along a slider's ray still count as attacked
+Bitboard attackedSquares(const PieceColor attackerColor, const Bitboards &);
+
+extern std::array<std::array<Bitboard, 64>, 64> betweenTable;
+extern std::array<std::array<Bitboard, 64>, 64> lineTable;
+
+// squares strictly between two squares sharing a rank, file or diagonal; 0 otherwise
+inline Bitboard betweenBitboard(const int a, const int b) { return betweenTable[a][b]; }
+
+// the whole rank, file or diagonal through two aligned squares; 0 otherwise
+inline Bitboard lineBitboard(const int a, const int b) { return lineTable[a][b]; }
+
+// ray-walking reference used to fill the magic tables
+Bitboard slidingAttacks(const int index, const std::vector<std::pair<int, int>> &offsets, const Bitboard occupied);
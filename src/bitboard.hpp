@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stddef.h>
+#include <vector>
+
+#include "types.hpp"
+#include "utils.hpp"
+
+// bit n of a bitboard corresponds to BoardIndex n (a8 = 0, h8 = 7, a1 = 56, h1 = 63)
+using Bitboard = uint64_t;
+
+constexpr Bitboard fileABitboard = 0x0101010101010101ULL;
+constexpr Bitboard fileHBitboard = fileABitboard << 7;
+constexpr Bitboard rank8Bitboard = 0xFFULL;
+constexpr Bitboard rank7Bitboard = rank8Bitboard << 8;
+constexpr Bitboard rank6Bitboard = rank8Bitboard << 16;
+constexpr Bitboard rank3Bitboard = rank8Bitboard << 40;
+constexpr Bitboard rank2Bitboard = rank8Bitboard << 48;
+constexpr Bitboard rank1Bitboard = rank8Bitboard << 56;
+
+constexpr Bitboard squareBitboard(const int index) { return Bitboard{1} << index; }
+
+inline int popCount(const Bitboard b) { return __builtin_popcountll(b); }
+
+inline int lsbIndex(const Bitboard b) { return __builtin_ctzll(b); }
+
+inline int popLsb(Bitboard &b)
+{
+  const int index = lsbIndex(b);
+  b &= b - 1;
+  return index;
+}
+
+// shifts every square by the same (file, rank) offset, dropping squares that leave the board
+constexpr Bitboard shiftBitboard(Bitboard b, const int fileOffset, const int rankOffset)
+{
+  const int shift = fileOffset - 8 * rankOffset;
+  b = shift > 0 ? b << shift : b >> -shift;
+
+  for (int i = 0; i < fileOffset; ++i)
+  {
+    b &= ~(fileABitboard << i);
+  }
+  for (int i = 0; i < -fileOffset; ++i)
+  {
+    b &= ~(fileHBitboard >> i);
+  }
+
+  return b;
+}
+
+inline std::vector<BoardIndex> bitboardToIndexes(Bitboard b)
+{
+  std::vector<BoardIndex> res;
+  res.reserve(popCount(b));
+  while (b)
+  {
+    res.emplace_back(popLsb(b));
+  }
+
+  return res;
+}
+
+constexpr size_t colorIndex(const PieceColor color) { return color == PieceColor::White ? 0 : 1; }
+
+struct Bitboards
+{
+  std::array<std::array<Bitboard, 6>, 2> pieces{};
+  std::array<Bitboard, 2> colors{};
+  Bitboard occupied = 0;
+
+  Bitboard pieceBitboard(const PieceColor color, const PieceType type) const
+  {
+    return pieces[colorIndex(color)][static_cast<size_t>(type)];
+  }
+
+  Bitboard colorBitboard(const PieceColor color) const { return colors[colorIndex(color)]; }
+
+  void addPiece(const int index, const ChessPiece piece)
+  {
+    const auto color = colorIndex(pieceColorOf(piece));
+    const Bitboard bit = squareBitboard(index);
+    pieces[color][static_cast<size_t>(pieceTypeOf(piece))] |= bit;
+    colors[color] |= bit;
+    occupied |= bit;
+  }
+
+  void removePiece(const int index, const ChessPiece piece)
+  {
+    const auto color = colorIndex(pieceColorOf(piece));
+    const Bitboard bit = ~squareBitboard(index);
+    pieces[color][static_cast<size_t>(pieceTypeOf(piece))] &= bit;
+    colors[color] &= bit;
+    occupied &= bit;
+  }
+
+  static Bitboards fromPiecePlacement(const PiecePlacement &piecePlacement)
+  {
+    Bitboards res;
+    for (int i = 0; i < 64; ++i)
+    {
+      if (piecePlacement[i] != ChessPiece::Empty)
+      {
+        res.addPiece(i, piecePlacement[i]);
+      }
+    }
+
+    return res;
+  }
+
+  bool operator==(const Bitboards &other) const
+  {
+    return pieces == other.pieces && colors == other.colors && occupied == other.occupied;
+  }
+};
@@ -5,53 +5,26 @@
 #include <optional>
 #include <random>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "config.hpp"
 #include "constants.hpp"
+#include "gameState.hpp"
+#include "move.hpp"
 #include "moveInput.hpp"
-#include "piece.hpp"
-#include "positionHash.hpp"
 #include "renderer/renderer.hpp"
 #include "timeControl.hpp"
 #include "types.hpp"
 
 class Game
 {
-  friend class Piece;
-  friend class Pawn;
-  friend class Knight;
-  friend class Bishop;
-  friend class Rook;
-  friend class Queen;
-  friend class King;
   friend class ChessTimer;
   friend class MoveInput;
   friend class FrameBuilder;
 
 public:
-  struct GameState
-  {
-    PiecePlacement piecePlacement = startingPiecePlacement;
-    PieceColor activeColor = PieceColor::White;
-    CastlingAvailability castlingAvailability = startingCastlingAvailability;
-    std::optional<BoardIndex> enPassantIndex = std::nullopt;
-    int halfmoveClock = 0;
-    int fullmoveClock = 1;
-
-    static GameState newGameState() { return {}; };
-    static GameState fromFEN(const std::string &fen);
-
-    bool operator==(const GameState &other) const
-    {
-      return (
-          piecePlacement == other.piecePlacement && activeColor == other.activeColor &&
-          castlingAvailability == other.castlingAvailability && enPassantIndex == other.enPassantIndex &&
-          halfmoveClock == other.halfmoveClock && fullmoveClock == other.fullmoveClock);
-    };
-  };
+  using GameState = ::GameState;
 
   enum class ModalState
   {
@@ -67,7 +40,10 @@ public:
   std::string getFenStr() const;
   PiecePlacement getPiecePlacement() const { return state.piecePlacement; }
   CastlingAvailability getCastlingAvailability() const { return state.castlingAvailability; }
-  std::optional<BoardIndex> getEnPassantIndex() const { return state.enPassantIndex; }
+  std::optional<BoardIndex> getEnPassantIndex() const
+  {
+    return state.enPassantIndex ? std::optional<BoardIndex>{*state.enPassantIndex} : std::nullopt;
+  }
   int getHalfMoveClock() { return state.halfmoveClock; }
 
   bool isWhiteMove() const;
@@ -77,9 +53,8 @@ public:
   static bool isKingInCheck(const PieceColor, const PiecePlacement &);
 
   bool isGameOver = false;
-  std::vector<MoveListItem> moveList;
+  std::vector<MoveRecord> moveList;
   std::string message;
-  std::unordered_map<Position, int, PositionHash> positionCount;
 
   ChessTimer timer{*this};
 
@@ -96,26 +71,20 @@ private:
 
   ModalState modalState;
 
-  Pawn pawn;
-  Knight knight;
-  Bishop bishop;
-  Rook rook;
-  Queen queen;
-  King king;
-
   MoveInput moveInput = MoveInput{*this};
 
   std::mt19937 randomGenerator;
 
+  // legal moves of the side to move, regenerated on first use after state.zobristKey changes
+  mutable MoveList legalMoveCache;
+  mutable std::optional<uint64_t> legalMoveCacheKey;
+
+  const MoveList &legalMoves() const;
+  void generatePieceMoves(const BoardIndex, MoveList &) const;
   std::pair<BoardIndex, BoardIndex> generateCpuMove(const PieceColor);
-  void updateHalfMoveClock(const ChessPiece, const ChessPiece);
-  bool handleEnPassant(const BoardIndex, const BoardIndex);
-  ChessPiece handlePawnPromotion(const ChessPiece, const BoardIndex);
-  std::string handleCastling(const BoardIndex, const BoardIndex);
+  PieceType selectPromotionType(const PieceColor);
+  Move resolveMove(const BoardIndex, const BoardIndex);
   bool handleGameOver();
-  void incrementPositionCount();
-  std::vector<BoardIndex> getSamePieceIndexes(const BoardIndex, const BoardIndex) const;
-  static bool isSquareUnderAttack(const BoardIndex, const PieceColor, const PiecePlacement &);
 
   friend struct GameTester;
 };
@@ -132,40 +101,9 @@ public:
     return game.getPieceLegalMoves(index);
   };
 
-  void testUpdateHalfMoveClock(const ChessPiece fromPiece, const ChessPiece toPiece)
-  {
-    return game.updateHalfMoveClock(fromPiece, toPiece);
-  }
-
-  bool testHandleEnPassant(const BoardIndex fromIndex, const BoardIndex toIndex)
-  {
-    return game.handleEnPassant(fromIndex, toIndex);
-  }
-
-  ChessPiece testHandlePawnPromotion(const ChessPiece fromPiece, const BoardIndex toIndex)
-  {
-    return game.handlePawnPromotion(fromPiece, toIndex);
-  }
-
-  std::string testHandleCastling(const BoardIndex fromIndex, const BoardIndex toIndex)
-  {
-    return game.handleCastling(fromIndex, toIndex);
-  }
-
-  std::vector<BoardIndex> testGetSamePieceIndexes(const BoardIndex fromIndex, const BoardIndex toIndex) const
-  {
-    return game.getSamePieceIndexes(fromIndex, toIndex);
-  }
-
-  bool
-  testIsSquareUnderAttack(const BoardIndex index, const PieceColor defenderColor, const PiecePlacement &piecePlacement)
-  {
-    return game.isSquareUnderAttack(index, defenderColor, piecePlacement);
-  }
-
   bool testHandleGameOver() { return game.handleGameOver(); }
 
-  void testIncrementPositionCount() { return game.incrementPositionCount(); }
+  void testMakeMove(const Move move) { game.state.makeMove(move); }
 
 private:
   Game &game;
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stddef.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "attacks.hpp"
+#include "bitboard.hpp"
+#include "gameState.hpp"
+#include "material.hpp"
+#include "move.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+#include "zobrist.hpp"
+
+GameState GameState::fromFEN(const std::string &fen)
+{
+  GameState res{};
+  size_t pos = 0;
+  std::string token;
+  std::string fen_copy = fen;
+
+  for (int tokenCount = 1; tokenCount != 7; ++tokenCount)
+  {
+    pos = fen_copy.find(' ');
+    token = fen_copy.substr(0, pos);
+    fen_copy.erase(0, pos + 1);
+
+    switch (tokenCount)
+    {
+    case 1:
+      res.piecePlacement = piecePlacementStringToArray(token);
+      break;
+    case 2:
+      res.activeColor = charToColor(token[0]);
+      break;
+    case 3:
+      res.castlingAvailability = parseCastlingAvailability(token);
+      break;
+    case 4:
+      res.enPassantIndex = token == "-" ? std::nullopt : std::optional{algebraicToIndex(token)};
+      break;
+    case 5:
+      res.halfmoveClock = token == "-" ? 0 : std::stoi(token);
+      if (res.halfmoveClock < 0 || res.halfmoveClock > UINT16_MAX)
+      {
+        throw std::invalid_argument("fromFEN(): halfmove clock out of range");
+      }
+      break;
+    case 6:
+      res.fullmoveClock = std::stoi(token);
+      break;
+    default:
+      break;
+    }
+  }
+
+  res.syncBitboards();
+
+  // keeps every count, promotions included, within its material key nibble
+  for (const auto color : {PieceColor::White, PieceColor::Black})
+  {
+    if (popCount(res.bitboards.colorBitboard(color)) > 16 ||
+        popCount(res.bitboards.pieceBitboard(color, PieceType::Pawn)) > 8)
+    {
+      throw std::invalid_argument("fromFEN(): too many pieces");
+    }
+  }
+
+  return res;
+};
+
+void GameState::syncBitboards()
+{
+  bitboards = Bitboards::fromPiecePlacement(piecePlacement);
+  zobristKey = computeZobristKey();
+  materialKey = computeMaterialKey();
+  isAttackMapValid = {};
+}
+
+uint64_t GameState::computeZobristKey() const
+{
+  uint64_t key = zobrist::castlingKey(castlingAvailability) ^ zobrist::enPassantKey(enPassantIndex);
+  if (activeColor == PieceColor::Black)
+  {
+    key ^= zobrist::keys.blackToMove;
+  }
+
+  for (size_t color = 0; color < 2; ++color)
+  {
+    for (size_t type = 0; type < 6; ++type)
+    {
+      Bitboard pieces = bitboards.pieces[color][type];
+      while (pieces)
+      {
+        key ^= zobrist::keys.pieces[color][type][popLsb(pieces)];
+      }
+    }
+  }
+
+  return key;
+}
+
+Bitboard GameState::attackMap(const PieceColor attackerColor) const
+{
+  const auto i = colorIndex(attackerColor);
+  if (!isAttackMapValid[i])
+  {
+    attackMaps[i] = attackedSquares(attackerColor, bitboards);
+    isAttackMapValid[i] = true;
+  }
+
+  return attackMaps[i];
+}
+
+uint64_t GameState::computeMaterialKey() const
+{
+  MaterialKey key = 0;
+  for (const auto color : {PieceColor::White, PieceColor::Black})
+  {
+    for (size_t type = 0; type < 6; ++type)
+    {
+      const auto pieceType = static_cast<PieceType>(type);
+      key += popCount(bitboards.pieceBitboard(color, pieceType)) * materialKeyDelta(color, pieceType);
+    }
+  }
+
+  return key;
+}
+
+void GameState::placePiece(const Square index, const ChessPiece piece)
+{
+  clearSquare(index);
+  if (piece != ChessPiece::Empty)
+  {
+    bitboards.addPiece(index, piece);
+    zobristKey ^= zobrist::pieceKey(piece, index);
+    materialKey += materialKeyDelta(pieceColorOf(piece), pieceTypeOf(piece));
+  }
+  piecePlacement[index] = piece;
+}
+
+void GameState::clearSquare(const Square index)
+{
+  const auto piece = piecePlacement[index];
+  if (piece != ChessPiece::Empty)
+  {
+    bitboards.removePiece(index, piece);
+    zobristKey ^= zobrist::pieceKey(piece, index);
+    materialKey -= materialKeyDelta(pieceColorOf(piece), pieceTypeOf(piece));
+  }
+  piecePlacement[index] = ChessPiece::Empty;
+  isAttackMapValid = {};
+}
+
+// a move from or to a king or rook home square gives up the castling rights tied to it
+static void updateCastlingAvailability(CastlingAvailability &castlingAvailability, const int index)
+{
+  switch (index)
+  {
+  case 60:
+    castlingAvailability.whiteShort = false;
+    castlingAvailability.whiteLong = false;
+    break;
+  case 63:
+    castlingAvailability.whiteShort = false;
+    break;
+  case 56:
+    castlingAvailability.whiteLong = false;
+    break;
+  case 4:
+    castlingAvailability.blackShort = false;
+    castlingAvailability.blackLong = false;
+    break;
+  case 7:
+    castlingAvailability.blackShort = false;
+    break;
+  case 0:
+    castlingAvailability.blackLong = false;
+    break;
+  default:
+    break;
+  }
+}
+
+static uint8_t packCastlingAvailability(const CastlingAvailability &castlingAvailability)
+{
+  return castlingAvailability.whiteShort | castlingAvailability.whiteLong << 1 |
+         castlingAvailability.blackShort << 2 | castlingAvailability.blackLong << 3;
+}
+
+static CastlingAvailability unpackCastlingAvailability(const uint8_t castlingRights)
+{
+  return {
+      static_cast<bool>(castlingRights & 1),
+      static_cast<bool>(castlingRights & 2),
+      static_cast<bool>(castlingRights & 4),
+      static_cast<bool>(castlingRights & 8)};
+}
+
+// rook squares for a castling move with the king landing on kingToIndex
+static std::pair<int, int> castlingRookIndexes(const int kingFromIndex, const int kingToIndex)
+{
+  return kingToIndex > kingFromIndex ? std::pair{kingToIndex + 1, kingToIndex - 1}
+                                     : std::pair{kingToIndex - 2, kingToIndex + 1};
+}
+
+void GameState::makeMove(const Move move)
+{
+  const int fromIndex = move.fromIndex();
+  const int toIndex = move.toIndex();
+  const auto piece = piecePlacement[fromIndex];
+  const auto color = pieceColorOf(piece);
+  const int capturedIndex =
+      move.type() == MoveType::EnPassant ? toIndex + (color == PieceColor::White ? 8 : -8) : toIndex;
+  const auto capturedPiece = piecePlacement[capturedIndex];
+
+  history.push_back(
+      {zobristKey,
+       move,
+       static_cast<uint16_t>(halfmoveClock),
+       capturedPiece,
+       packCastlingAvailability(castlingAvailability),
+       static_cast<int8_t>(enPassantIndex.has_value() ? static_cast<int>(enPassantIndex.value()) : -1)});
+  zobristKey ^= zobrist::castlingKey(castlingAvailability) ^ zobrist::enPassantKey(enPassantIndex);
+
+  clearSquare(capturedIndex);
+  clearSquare(fromIndex);
+  placePiece(toIndex, move.type() == MoveType::Promotion ? makeChessPiece(color, move.promotionType()) : piece);
+
+  if (move.type() == MoveType::Castling)
+  {
+    const auto [rookFromIndex, rookToIndex] = castlingRookIndexes(fromIndex, toIndex);
+    clearSquare(rookFromIndex);
+    placePiece(rookToIndex, makeChessPiece(color, PieceType::Rook));
+  }
+
+  updateCastlingAvailability(castlingAvailability, fromIndex);
+  updateCastlingAvailability(castlingAvailability, toIndex);
+
+  const bool isPawnMove = pieceTypeOf(piece) == PieceType::Pawn;
+  if (isPawnMove && abs(fromIndex - toIndex) == 16)
+  {
+    enPassantIndex = (fromIndex + toIndex) / 2;
+  }
+  else
+  {
+    enPassantIndex.reset();
+  }
+
+  halfmoveClock = isPawnMove || capturedPiece != ChessPiece::Empty ? 0 : halfmoveClock + 1;
+  if (activeColor == PieceColor::Black)
+  {
+    ++fullmoveClock;
+  }
+  activeColor = !activeColor;
+  zobristKey ^= zobrist::castlingKey(castlingAvailability) ^ zobrist::enPassantKey(enPassantIndex) ^
+                zobrist::keys.blackToMove;
+}
+
+void GameState::unmakeMove()
+{
+  if (history.empty())
+  {
+    throw std::out_of_range("unmakeMove(): no move to unmake");
+  }
+
+  const auto record = history.back();
+  history.pop_back();
+
+  activeColor = !activeColor;
+  if (activeColor == PieceColor::Black)
+  {
+    --fullmoveClock;
+  }
+
+  const auto move = record.move;
+  const int fromIndex = move.fromIndex();
+  const int toIndex = move.toIndex();
+  const auto color = pieceColorOf(piecePlacement[toIndex]);
+  const auto piece =
+      move.type() == MoveType::Promotion ? makeChessPiece(color, PieceType::Pawn) : piecePlacement[toIndex];
+
+  clearSquare(toIndex);
+  placePiece(fromIndex, piece);
+
+  if (move.type() == MoveType::Castling)
+  {
+    const auto [rookFromIndex, rookToIndex] = castlingRookIndexes(fromIndex, toIndex);
+    clearSquare(rookToIndex);
+    placePiece(rookFromIndex, makeChessPiece(color, PieceType::Rook));
+  }
+
+  if (record.capturedPiece != ChessPiece::Empty)
+  {
+    const int capturedIndex =
+        move.type() == MoveType::EnPassant ? toIndex + (color == PieceColor::White ? 8 : -8) : toIndex;
+    placePiece(capturedIndex, record.capturedPiece);
+  }
+
+  castlingAvailability = unpackCastlingAvailability(record.castlingRights);
+  enPassantIndex = record.enPassantIndex < 0 ? std::nullopt : std::optional<Square>{record.enPassantIndex};
+  halfmoveClock = record.halfmoveClock;
+  zobristKey = record.zobristKey;
+}
+
+bool GameState::isThreefoldRepetition() const
+{
+  // history[i].zobristKey is the position before move i, so history.back() is one ply back
+  const int plies = std::min(halfmoveClock, static_cast<int>(history.size()));
+  int repetitions = 0;
+  for (int ply = 2; ply <= plies; ply += 2)
+  {
+    if (history[history.size() - ply].zobristKey == zobristKey && ++repetitions == 2)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bitboard.hpp"
+#include "constants.hpp"
+#include "move.hpp"
+#include "types.hpp"
+
+// Everything makeMove() overwrites that cannot be recovered from the move itself. The whole game's
+// history doubles as the repetition store, so it is packed into 16 bytes.
+struct UndoRecord
+{
+  uint64_t zobristKey;
+  Move move;
+  uint16_t halfmoveClock;
+  ChessPiece capturedPiece;
+  uint8_t castlingRights; // one bit per CastlingAvailability field, in declaration order
+  int8_t enPassantIndex;  // -1 when there was none
+};
+
+static_assert(sizeof(UndoRecord) == 16);
+
+struct GameState
+{
+  PiecePlacement piecePlacement = startingPiecePlacement;
+  PieceColor activeColor = PieceColor::White;
+  CastlingAvailability castlingAvailability = startingCastlingAvailability;
+  std::optional<Square> enPassantIndex = std::nullopt;
+  int halfmoveClock = 0;
+  int fullmoveClock = 1;
+  Bitboards bitboards = Bitboards::fromPiecePlacement(startingPiecePlacement);
+  // hash of everything but the clocks, kept up to date by every write below
+  uint64_t zobristKey = computeZobristKey();
+  // piece counts per side and type, see material.hpp
+  uint64_t materialKey = computeMaterialKey();
+
+  static GameState newGameState() { return {}; };
+  static GameState fromFEN(const std::string &fen);
+
+  // all board writes go through these so bitboards and the keys stay in sync with piecePlacement;
+  // syncBitboards() rebuilds them after the fields were assigned directly
+  void placePiece(const Square, const ChessPiece);
+  void clearSquare(const Square);
+  void syncBitboards();
+
+  uint64_t computeZobristKey() const;
+  uint64_t computeMaterialKey() const;
+
+  // plays a legal move for the side to move and pushes an undo record; unmakeMove() pops it
+  void makeMove(const Move);
+  void unmakeMove();
+
+  // Whether the current position occurred twice before in history. Only every other earlier position
+  // since the last capture or pawn move can equal it, so at most halfmoveClock / 2 keys are compared.
+  bool isThreefoldRepetition() const;
+
+  // squares attacked by attackerColor (see attackedSquares()), computed on first use after each board write
+  Bitboard attackMap(const PieceColor attackerColor) const;
+  bool isInCheck(const PieceColor color) const
+  {
+    return bitboards.pieceBitboard(color, PieceType::King) & attackMap(!color);
+  }
+
+  std::vector<UndoRecord> history{};
+
+  mutable std::array<Bitboard, 2> attackMaps{};
+  mutable std::array<bool, 2> isAttackMapValid{};
+
+  bool operator==(const GameState &other) const
+  {
+    return (
+        piecePlacement == other.piecePlacement && activeColor == other.activeColor &&
+        castlingAvailability == other.castlingAvailability && enPassantIndex == other.enPassantIndex &&
+        halfmoveClock == other.halfmoveClock && fullmoveClock == other.fullmoveClock);
+  };
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stddef.h>
+#include <utility>
+
+#include "bitboard.hpp"
+#include "types.hpp"
+
+// Piece counts of both sides packed into one integer, a nibble per piece type: white pawn..king in bits 0-23,
+// black in bits 24-47. Adding or removing a piece is a single add, so GameState keeps it current for free.
+// A nibble holds 15, which is enough since GameState::fromFEN allows at most 16 pieces and 8 pawns per side.
+using MaterialKey = uint64_t;
+
+// side material without the king, i.e. the pawn..queen nibbles of one color
+using MaterialSignature = uint32_t;
+
+constexpr MaterialKey materialKeyDelta(const PieceColor color, const PieceType type)
+{
+  return MaterialKey{1} << ((colorIndex(color) * 6 + static_cast<size_t>(type)) * 4);
+}
+
+constexpr int pieceCount(const MaterialKey key, const PieceColor color, const PieceType type)
+{
+  return static_cast<int>((key / materialKeyDelta(color, type)) & 0xF);
+}
+
+constexpr MaterialSignature materialSignature(const MaterialKey key, const PieceColor color)
+{
+  return static_cast<MaterialSignature>((key >> (colorIndex(color) * 24)) & 0xFFFFF);
+}
+
+namespace material
+{
+constexpr MaterialSignature lone = 0;
+// white's nibbles start at bit 0, so its deltas are also signatures
+constexpr MaterialSignature knight = materialKeyDelta(PieceColor::White, PieceType::Knight);
+constexpr MaterialSignature bishop = materialKeyDelta(PieceColor::White, PieceType::Bishop);
+constexpr MaterialSignature twoKnights = 2 * knight;
+
+// a king with only these can never give mate
+inline constexpr std::array<MaterialSignature, 4> cannotMate = {lone, knight, bishop, twoKnights};
+
+// pairs of sides, in either order, for which no sequence of legal moves ends in mate
+inline constexpr std::array<std::pair<MaterialSignature, MaterialSignature>, 7> insufficient = {{
+    {lone, lone},
+    {knight, lone},
+    {bishop, lone},
+    {twoKnights, lone},
+    {knight, knight},
+    {knight, bishop},
+    {bishop, bishop},
+}};
+} // namespace material
+
+constexpr bool canCheckmate(const MaterialKey key, const PieceColor color)
+{
+  const auto signature = materialSignature(key, color);
+  for (const auto entry : material::cannotMate)
+  {
+    if (signature == entry)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool isInsufficientMaterial(const MaterialKey key)
+{
+  const auto white = materialSignature(key, PieceColor::White);
+  const auto black = materialSignature(key, PieceColor::Black);
+  for (const auto &[a, b] : material::insufficient)
+  {
+    if ((white == a && black == b) || (white == b && black == a))
+    {
+      return true;
+    }
+  }
+  return false;
+}
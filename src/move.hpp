@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stddef.h>
+#include <stdexcept>
+#include <type_traits>
+
+#include "types.hpp"
+
+enum class MoveType : uint16_t
+{
+  Normal,
+  Promotion,
+  EnPassant,
+  Castling,
+};
+
+// packed into 16 bits: from (6) | to (6) | promotion piece (2, knight..queen) | type (2). Trivially default
+// constructible so a MoveList does not zero its buffer on every search node.
+class Move
+{
+public:
+  Move() = default;
+
+  constexpr Move(
+      const int fromIndex,
+      const int toIndex,
+      const MoveType type = MoveType::Normal,
+      const PieceType promotionType = PieceType::Knight)
+      : data(static_cast<uint16_t>(
+            fromIndex | (toIndex << 6) |
+            ((static_cast<int>(promotionType) - static_cast<int>(PieceType::Knight)) << 12) |
+            (static_cast<int>(type) << 14)))
+  {
+  }
+
+  constexpr int fromIndex() const { return data & 0x3F; }
+  constexpr int toIndex() const { return (data >> 6) & 0x3F; }
+  constexpr MoveType type() const { return static_cast<MoveType>(data >> 14); }
+  constexpr PieceType promotionType() const
+  {
+    return static_cast<PieceType>(((data >> 12) & 0x3) + static_cast<int>(PieceType::Knight));
+  }
+
+  constexpr bool operator==(const Move &other) const { return data == other.data; }
+  constexpr bool operator!=(const Move &other) const { return data != other.data; }
+
+private:
+  uint16_t data;
+};
+
+static_assert(sizeof(Move) == 2);
+static_assert(std::is_trivially_default_constructible_v<Move>);
+
+// A played move as kept in the game's move list. It records just enough of the position it was played in for
+// SAN to be derived from it later (see FrameBuilder::makeMoveListEntries).
+struct MoveRecord
+{
+  enum Flag : uint8_t
+  {
+    Capture = 1 << 0,
+    Check = 1 << 1,
+    FileNeeded = 1 << 2, // another piece of the same type could move there too
+    RankNeeded = 1 << 3,
+  };
+
+  Move move;
+  ChessPiece piece;
+  uint8_t flags = 0;
+
+  constexpr bool has(const Flag flag) const { return flags & flag; }
+};
+
+static_assert(sizeof(MoveRecord) == 4);
+
+// no reachable position has more than 218 legal moves
+class MoveList
+{
+public:
+  static constexpr size_t capacity = 256;
+
+  void push(const Move move)
+  {
+    if (count == capacity)
+    {
+      throw std::out_of_range("MoveList::push(): capacity exceeded");
+    }
+    moves[count++] = move;
+  }
+
+  void clear() { count = 0; }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  const Move &operator[](const size_t i) const { return moves[i]; }
+  Move &operator[](const size_t i) { return moves[i]; }
+
+  const Move *begin() const { return moves.data(); }
+  const Move *end() const { return moves.data() + count; }
+  Move *begin() { return moves.data(); }
+  Move *end() { return moves.data() + count; }
+
+  bool contains(const Move move) const { return std::find(begin(), end(), move) != end(); }
+
+private:
+  std::array<Move, capacity> moves;
+  size_t count = 0;
+};
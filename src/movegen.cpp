@@ -0,0 +1,828 @@
+#include "movegen.hpp"
+
+#include <array>
+#include <stddef.h>
+#include <stdexcept>
+#include <vector>
+
+#include "attacks.hpp"
+#include "bitboard.hpp"
+#include "gameState.hpp"
+#include "move.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+// The generator is instantiated per color and piece type, so pawn directions, rank masks and the
+// attack function of each piece are compile-time constants rather than runtime branches.
+
+struct CastlingRule
+{
+  bool CastlingAvailability::*right;
+  int kingFromIndex;
+  int kingToIndex;
+  int rookFromIndex;
+  int passIndex;    // square the king crosses, must not be attacked
+  Bitboard between; // must be empty
+};
+
+template <PieceColor Us>
+struct ColorTraits;
+
+template <>
+struct ColorTraits<PieceColor::White>
+{
+  static constexpr int pawnRankOffset = 1;
+  static constexpr int pawnPushIndexOffset = -8;
+  static constexpr Bitboard startRank = rank2Bitboard;
+  static constexpr Bitboard enPassantRank = rank6Bitboard;
+  static constexpr Bitboard promotionRank = rank8Bitboard;
+  static constexpr std::array<CastlingRule, 2> castlingRules = {{
+      {&CastlingAvailability::whiteShort, 60, 62, 63, 61, squareBitboard(61) | squareBitboard(62)},
+      {&CastlingAvailability::whiteLong, 60, 58, 56, 59, squareBitboard(57) | squareBitboard(58) | squareBitboard(59)},
+  }};
+};
+
+template <>
+struct ColorTraits<PieceColor::Black>
+{
+  static constexpr int pawnRankOffset = -1;
+  static constexpr int pawnPushIndexOffset = 8;
+  static constexpr Bitboard startRank = rank7Bitboard;
+  static constexpr Bitboard enPassantRank = rank3Bitboard;
+  static constexpr Bitboard promotionRank = rank1Bitboard;
+  static constexpr std::array<CastlingRule, 2> castlingRules = {{
+      {&CastlingAvailability::blackShort, 4, 6, 7, 5, squareBitboard(5) | squareBitboard(6)},
+      {&CastlingAvailability::blackLong, 4, 2, 0, 3, squareBitboard(1) | squareBitboard(2) | squareBitboard(3)},
+  }};
+};
+
+static constexpr std::array<PieceType, 4> promotionTypes = {
+    PieceType::Queen,
+    PieceType::Rook,
+    PieceType::Bishop,
+    PieceType::Knight};
+
+bool isSquareAttacked(const int index, const PieceColor defenderColor, const Bitboards &bitboards)
+{
+  const auto attackerColor = !defenderColor;
+  const auto attackers = [&](const PieceType type) { return bitboards.pieceBitboard(attackerColor, type); };
+  const Bitboard queens = attackers(PieceType::Queen);
+
+  // a defender pawn on index attacks exactly the squares an attacker pawn must stand on to attack index
+  return (pawnAttacks(defenderColor, index) & attackers(PieceType::Pawn)) ||
+         (knightAttacks(index) & attackers(PieceType::Knight)) ||
+         (bishopAttacks(index, bitboards.occupied) & (attackers(PieceType::Bishop) | queens)) ||
+         (rookAttacks(index, bitboards.occupied) & (attackers(PieceType::Rook) | queens)) ||
+         (kingAttacks(index) & attackers(PieceType::King));
+}
+
+bool isKingAttacked(const PieceColor color, const Bitboards &bitboards)
+{
+  const auto king = bitboards.pieceBitboard(color, PieceType::King);
+  if (!king)
+  {
+    return false;
+  }
+
+  return isSquareAttacked(lsbIndex(king), color, bitboards);
+}
+
+// Computed once per position and side: a non-king move is legal when its destination is in checkMask
+// (blocks or captures a single checker) and a pinned piece stays on the line through its king.
+struct MoveMasks
+{
+  int kingIndex; // -1 without a king
+  Bitboard checkers;
+  Bitboard checkMask;
+  Bitboard pinned;
+};
+
+template <PieceColor Us>
+static MoveMasks computeMoveMasks(const Bitboards &bitboards)
+{
+  constexpr PieceColor Them = !Us;
+  MoveMasks masks{-1, 0, ~Bitboard{0}, 0};
+
+  const Bitboard king = bitboards.pieceBitboard(Us, PieceType::King);
+  if (!king)
+  {
+    return masks;
+  }
+
+  const int kingIndex = lsbIndex(king);
+  const auto enemies = [&](const PieceType type) { return bitboards.pieceBitboard(Them, type); };
+  const Bitboard queens = enemies(PieceType::Queen);
+  const Bitboard diagonalSliders = enemies(PieceType::Bishop) | queens;
+  const Bitboard orthogonalSliders = enemies(PieceType::Rook) | queens;
+
+  masks.kingIndex = kingIndex;
+  masks.checkers = (pawnAttacks(Us, kingIndex) & enemies(PieceType::Pawn)) |
+                   (knightAttacks(kingIndex) & enemies(PieceType::Knight)) |
+                   (bishopAttacks(kingIndex, bitboards.occupied) & diagonalSliders) |
+                   (rookAttacks(kingIndex, bitboards.occupied) & orthogonalSliders);
+
+  if (popCount(masks.checkers) > 1)
+  {
+    masks.checkMask = 0;
+  }
+  else if (masks.checkers)
+  {
+    masks.checkMask = betweenBitboard(kingIndex, lsbIndex(masks.checkers)) | masks.checkers;
+  }
+
+  // sliders that see the king through our own pieces; exactly one piece in between is pinned
+  const Bitboard enemyPieces = bitboards.colorBitboard(Them);
+  Bitboard snipers = (bishopAttacks(kingIndex, enemyPieces) & diagonalSliders) |
+                     (rookAttacks(kingIndex, enemyPieces) & orthogonalSliders);
+  while (snipers)
+  {
+    const Bitboard blockers = betweenBitboard(kingIndex, popLsb(snipers)) & bitboards.occupied;
+    if (popCount(blockers) == 1 && (blockers & bitboards.colorBitboard(Us)))
+    {
+      masks.pinned |= blockers;
+    }
+  }
+
+  return masks;
+}
+
+static Bitboard legalTargets(const MoveMasks &masks, const int fromIndex, Bitboard targets)
+{
+  targets &= masks.checkMask;
+  if (masks.pinned & squareBitboard(fromIndex))
+  {
+    targets &= lineBitboard(masks.kingIndex, fromIndex);
+  }
+
+  return targets;
+}
+
+static void addMoves(const int fromIndex, Bitboard targets, MoveList &moves)
+{
+  while (targets)
+  {
+    moves.push(Move(fromIndex, popLsb(targets)));
+  }
+}
+
+// en passant removes two pieces from the capturing rank, which the pin masks cannot see, so it is played out
+template <PieceColor Us>
+static bool isEnPassantLegal(const Bitboards &bitboards, const int fromIndex, const int toIndex)
+{
+  constexpr auto pawn = makeChessPiece(Us, PieceType::Pawn);
+
+  auto res = bitboards;
+  res.removePiece(fromIndex, pawn);
+  res.removePiece(toIndex - ColorTraits<Us>::pawnPushIndexOffset, makeChessPiece(!Us, PieceType::Pawn));
+  res.addPiece(toIndex, pawn);
+
+  return !isKingAttacked(Us, res);
+}
+
+// legal pawn pushes and captures from one square, en passant aside
+template <PieceColor Us, GenType Gen>
+static Bitboard pawnTargets(const Bitboards &bitboards, const MoveMasks &masks, const int fromIndex)
+{
+  using Traits = ColorTraits<Us>;
+  const Bitboard origin = squareBitboard(fromIndex);
+  const Bitboard empty = ~bitboards.occupied;
+
+  // 1 rank, then 2 ranks from the start rank if the first square was free
+  Bitboard targets = shiftBitboard(origin, 0, Traits::pawnRankOffset) & empty;
+  if (origin & Traits::startRank)
+  {
+    targets |= shiftBitboard(targets, 0, Traits::pawnRankOffset) & empty;
+  }
+
+  // quiet promotions belong to the captures stage
+  if constexpr (Gen == GenType::Captures)
+  {
+    targets &= Traits::promotionRank;
+  }
+  else if constexpr (Gen == GenType::Quiets)
+  {
+    targets &= ~Traits::promotionRank;
+  }
+
+  if constexpr (Gen != GenType::Quiets)
+  {
+    targets |= pawnAttacks(Us, fromIndex) & bitboards.colorBitboard(!Us);
+  }
+
+  return legalTargets(masks, fromIndex, targets);
+}
+
+// which of the given pawns can legally take en passant
+template <PieceColor Us>
+static Bitboard enPassantCapturers(const GameState &state, const Bitboard pawns)
+{
+  using Traits = ColorTraits<Us>;
+  const auto &bitboards = state.bitboards;
+  if (!state.enPassantIndex.has_value())
+  {
+    return 0;
+  }
+
+  const int enPassantIndex = state.enPassantIndex.value();
+  const int capturedIndex = enPassantIndex - Traits::pawnPushIndexOffset;
+  if (!(squareBitboard(enPassantIndex) & Traits::enPassantRank) ||
+      !(bitboards.pieceBitboard(!Us, PieceType::Pawn) & squareBitboard(capturedIndex)))
+  {
+    return 0;
+  }
+
+  // our pawns that attack the en passant square stand where an enemy pawn on it would attack
+  Bitboard candidates = pawnAttacks(!Us, enPassantIndex) & pawns;
+  Bitboard res = 0;
+  while (candidates)
+  {
+    const int fromIndex = popLsb(candidates);
+    if (isEnPassantLegal<Us>(bitboards, fromIndex, enPassantIndex))
+    {
+      res |= squareBitboard(fromIndex);
+    }
+  }
+
+  return res;
+}
+
+template <PieceColor Us, GenType Gen>
+static void generatePawnMoves(const GameState &state, const MoveMasks &masks, const Bitboard pawns, MoveList &moves)
+{
+  using Traits = ColorTraits<Us>;
+
+  Bitboard remaining = pawns;
+  while (remaining)
+  {
+    const int fromIndex = popLsb(remaining);
+    const Bitboard targets = pawnTargets<Us, Gen>(state.bitboards, masks, fromIndex);
+
+    addMoves(fromIndex, targets & ~Traits::promotionRank, moves);
+
+    Bitboard promotions = targets & Traits::promotionRank;
+    while (promotions)
+    {
+      const int toIndex = popLsb(promotions);
+      for (const auto type : promotionTypes)
+      {
+        moves.push(Move(fromIndex, toIndex, MoveType::Promotion, type));
+      }
+    }
+  }
+
+  if constexpr (Gen != GenType::Quiets)
+  {
+    Bitboard capturers = enPassantCapturers<Us>(state, pawns);
+    while (capturers)
+    {
+      moves.push(Move(popLsb(capturers), state.enPassantIndex.value(), MoveType::EnPassant));
+    }
+  }
+}
+
+// destinations of the king's castling moves, none while in check
+template <PieceColor Us>
+static Bitboard castlingTargets(const GameState &state, const MoveMasks &masks, const int fromIndex)
+{
+  const auto &bitboards = state.bitboards;
+  if (masks.checkers)
+  {
+    return 0;
+  }
+
+  const Bitboard attacked = state.attackMap(!Us);
+  Bitboard res = 0;
+  for (const auto &rule : ColorTraits<Us>::castlingRules)
+  {
+    if (rule.kingFromIndex == fromIndex && state.castlingAvailability.*rule.right &&
+        (bitboards.pieceBitboard(Us, PieceType::Rook) & squareBitboard(rule.rookFromIndex)) &&
+        !(bitboards.occupied & rule.between) &&
+        !(attacked & (squareBitboard(rule.passIndex) | squareBitboard(rule.kingToIndex))))
+    {
+      res |= squareBitboard(rule.kingToIndex);
+    }
+  }
+
+  return res;
+}
+
+template <PieceColor Us, GenType Gen>
+static void generateKingMoves(
+    const GameState &state,
+    const MoveMasks &masks,
+    const int fromIndex,
+    const Bitboard targetMask,
+    MoveList &moves)
+{
+  addMoves(fromIndex, kingAttacks(fromIndex) & targetMask & ~state.attackMap(!Us), moves);
+
+  if constexpr (Gen != GenType::Captures)
+  {
+    Bitboard targets = castlingTargets<Us>(state, masks, fromIndex);
+    while (targets)
+    {
+      moves.push(Move(fromIndex, popLsb(targets), MoveType::Castling));
+    }
+  }
+}
+
+// moves of the given pieces, all of color Us and type Type, landing on targetMask
+template <PieceColor Us, PieceType Type, GenType Gen>
+static void generate(
+    const GameState &state,
+    const MoveMasks &masks,
+    Bitboard pieces,
+    const Bitboard targetMask,
+    MoveList &moves)
+{
+  if constexpr (Type == PieceType::Pawn)
+  {
+    generatePawnMoves<Us, Gen>(state, masks, pieces, moves);
+  }
+  else if constexpr (Type == PieceType::King)
+  {
+    while (pieces)
+    {
+      generateKingMoves<Us, Gen>(state, masks, popLsb(pieces), targetMask, moves);
+    }
+  }
+  else
+  {
+    const Bitboard occupied = state.bitboards.occupied;
+    while (pieces)
+    {
+      const int fromIndex = popLsb(pieces);
+      addMoves(fromIndex, legalTargets(masks, fromIndex, pieceAttacks<Type>(fromIndex, occupied) & targetMask), moves);
+    }
+  }
+}
+
+template <PieceColor Us, GenType Gen>
+static void generateAll(const GameState &state, MoveList &moves)
+{
+  const auto &bitboards = state.bitboards;
+  const auto masks = computeMoveMasks<Us>(bitboards);
+  const auto pieces = [&](const PieceType type) { return bitboards.pieceBitboard(Us, type); };
+
+  if (Gen == GenType::Evasions && !masks.checkers)
+  {
+    return;
+  }
+
+  Bitboard targetMask = ~bitboards.colorBitboard(Us);
+  if constexpr (Gen == GenType::Captures)
+  {
+    targetMask = bitboards.colorBitboard(!Us);
+  }
+  else if constexpr (Gen == GenType::Quiets)
+  {
+    targetMask = ~bitboards.occupied;
+  }
+
+  // in double check only the king may move
+  if (masks.checkMask)
+  {
+    generate<Us, PieceType::Pawn, Gen>(state, masks, pieces(PieceType::Pawn), targetMask, moves);
+    generate<Us, PieceType::Knight, Gen>(state, masks, pieces(PieceType::Knight), targetMask, moves);
+    generate<Us, PieceType::Bishop, Gen>(state, masks, pieces(PieceType::Bishop), targetMask, moves);
+    generate<Us, PieceType::Rook, Gen>(state, masks, pieces(PieceType::Rook), targetMask, moves);
+    generate<Us, PieceType::Queen, Gen>(state, masks, pieces(PieceType::Queen), targetMask, moves);
+  }
+  generate<Us, PieceType::King, Gen>(state, masks, pieces(PieceType::King), targetMask, moves);
+}
+
+// our pieces that are the only blocker between one of our sliders and the enemy king; moving one off
+// that line gives a discovered check
+template <PieceColor Us>
+static Bitboard discoveredCheckBlockers(const Bitboards &bitboards, const int kingIndex)
+{
+  const auto ours = [&](const PieceType type) { return bitboards.pieceBitboard(Us, type); };
+  const Bitboard queens = ours(PieceType::Queen);
+  const Bitboard enemyPieces = bitboards.colorBitboard(!Us);
+
+  Bitboard snipers = (bishopAttacks(kingIndex, enemyPieces) & (ours(PieceType::Bishop) | queens)) |
+                     (rookAttacks(kingIndex, enemyPieces) & (ours(PieceType::Rook) | queens));
+  Bitboard res = 0;
+  while (snipers)
+  {
+    const Bitboard blockers = betweenBitboard(kingIndex, popLsb(snipers)) & bitboards.occupied;
+    if (popCount(blockers) == 1 && (blockers & bitboards.colorBitboard(Us)))
+    {
+      res |= blockers;
+    }
+  }
+
+  return res;
+}
+
+// where a quiet move from fromIndex has to land to give check: a square attacking the enemy king, or
+// anywhere off the line of a discovered check
+static Bitboard checkTargets(const int kingIndex, const Bitboard discoverers, const int fromIndex, Bitboard squares)
+{
+  if (discoverers & squareBitboard(fromIndex))
+  {
+    squares |= ~lineBitboard(kingIndex, fromIndex);
+  }
+
+  return squares;
+}
+
+template <PieceColor Us, PieceType Type>
+static void generatePieceQuietChecks(
+    const Bitboards &bitboards,
+    const MoveMasks &masks,
+    const int kingIndex,
+    const Bitboard discoverers,
+    const Bitboard checkSquares,
+    MoveList &moves)
+{
+  const Bitboard occupied = bitboards.occupied;
+  Bitboard pieces = bitboards.pieceBitboard(Us, Type);
+  while (pieces)
+  {
+    const int fromIndex = popLsb(pieces);
+    const Bitboard targets = pieceAttacks<Type>(fromIndex, occupied) & ~occupied &
+                             checkTargets(kingIndex, discoverers, fromIndex, checkSquares);
+    addMoves(fromIndex, legalTargets(masks, fromIndex, targets), moves);
+  }
+}
+
+// Quiets are only generated onto check squares or off a discovered check line, so the quiet moves that
+// do not give check are never built.
+template <PieceColor Us>
+static void generateQuietChecks(const GameState &state, MoveList &moves)
+{
+  const auto &bitboards = state.bitboards;
+  const Bitboard enemyKing = bitboards.pieceBitboard(!Us, PieceType::King);
+  if (!enemyKing)
+  {
+    return;
+  }
+
+  const int kingIndex = lsbIndex(enemyKing);
+  const auto masks = computeMoveMasks<Us>(bitboards);
+  const Bitboard occupied = bitboards.occupied;
+  const Bitboard discoverers = discoveredCheckBlockers<Us>(bitboards, kingIndex);
+
+  // in double check only the king may move
+  if (masks.checkMask)
+  {
+    Bitboard pawns = bitboards.pieceBitboard(Us, PieceType::Pawn);
+    while (pawns)
+    {
+      const int fromIndex = popLsb(pawns);
+      const Bitboard targets = pawnTargets<Us, GenType::Quiets>(bitboards, masks, fromIndex) &
+                               checkTargets(kingIndex, discoverers, fromIndex, pawnAttacks(!Us, kingIndex));
+      addMoves(fromIndex, targets, moves);
+    }
+
+    const Bitboard bishopChecks = bishopAttacks(kingIndex, occupied);
+    const Bitboard rookChecks = rookAttacks(kingIndex, occupied);
+    generatePieceQuietChecks<Us, PieceType::Knight>(
+        bitboards, masks, kingIndex, discoverers, knightAttacks(kingIndex), moves);
+    generatePieceQuietChecks<Us, PieceType::Bishop>(bitboards, masks, kingIndex, discoverers, bishopChecks, moves);
+    generatePieceQuietChecks<Us, PieceType::Rook>(bitboards, masks, kingIndex, discoverers, rookChecks, moves);
+    generatePieceQuietChecks<Us, PieceType::Queen>(
+        bitboards, masks, kingIndex, discoverers, bishopChecks | rookChecks, moves);
+  }
+
+  Bitboard king = bitboards.pieceBitboard(Us, PieceType::King);
+  while (king)
+  {
+    const int fromIndex = popLsb(king);
+    const Bitboard targets = kingAttacks(fromIndex) & ~occupied & ~state.attackMap(!Us);
+    addMoves(fromIndex, targets & checkTargets(kingIndex, discoverers, fromIndex, 0), moves);
+
+    // the rook lands on the square the king crosses; nothing behind the king on the back rank can be uncovered
+    const Bitboard castlingMoves = castlingTargets<Us>(state, masks, fromIndex);
+    for (const auto &rule : ColorTraits<Us>::castlingRules)
+    {
+      const Bitboard castledOccupied = occupied ^ squareBitboard(rule.kingFromIndex) ^
+                                       squareBitboard(rule.kingToIndex) ^ squareBitboard(rule.rookFromIndex) ^
+                                       squareBitboard(rule.passIndex);
+      if ((castlingMoves & squareBitboard(rule.kingToIndex)) &&
+          (rookAttacks(rule.passIndex, castledOccupied) & enemyKing))
+      {
+        moves.push(Move(fromIndex, rule.kingToIndex, MoveType::Castling));
+      }
+    }
+  }
+}
+
+template <PieceColor Us>
+static void generateSquare(const GameState &state, const int index, MoveList &moves)
+{
+  const auto masks = computeMoveMasks<Us>(state.bitboards);
+  const Bitboard piece = squareBitboard(index);
+  const Bitboard notOwn = ~state.bitboards.colorBitboard(Us);
+
+  switch (pieceTypeOf(state.piecePlacement[index]))
+  {
+  case PieceType::Pawn:
+    generate<Us, PieceType::Pawn, GenType::Legal>(state, masks, piece, notOwn, moves);
+    break;
+  case PieceType::Knight:
+    generate<Us, PieceType::Knight, GenType::Legal>(state, masks, piece, notOwn, moves);
+    break;
+  case PieceType::Bishop:
+    generate<Us, PieceType::Bishop, GenType::Legal>(state, masks, piece, notOwn, moves);
+    break;
+  case PieceType::Rook:
+    generate<Us, PieceType::Rook, GenType::Legal>(state, masks, piece, notOwn, moves);
+    break;
+  case PieceType::Queen:
+    generate<Us, PieceType::Queen, GenType::Legal>(state, masks, piece, notOwn, moves);
+    break;
+  case PieceType::King:
+    generate<Us, PieceType::King, GenType::Legal>(state, masks, piece, notOwn, moves);
+    break;
+  }
+}
+
+// one destination bit is tested instead of building a move list
+template <PieceColor Us>
+static bool isLegalMove(const GameState &state, const int fromIndex, const int toIndex)
+{
+  const auto &bitboards = state.bitboards;
+  const Bitboard to = squareBitboard(toIndex);
+  if (to & bitboards.colorBitboard(Us))
+  {
+    return false;
+  }
+
+  const auto type = pieceTypeOf(state.piecePlacement[fromIndex]);
+  const Bitboard occupied = bitboards.occupied;
+
+  // cheap pseudo-legal rejection before computing pins and checks
+  if ((type == PieceType::Knight && !(knightAttacks(fromIndex) & to)) ||
+      (type == PieceType::Bishop && !(bishopAttacks(fromIndex, occupied) & to)) ||
+      (type == PieceType::Rook && !(rookAttacks(fromIndex, occupied) & to)) ||
+      (type == PieceType::Queen && !(queenAttacks(fromIndex, occupied) & to)))
+  {
+    return false;
+  }
+
+  const auto masks = computeMoveMasks<Us>(bitboards);
+  switch (type)
+  {
+  case PieceType::Pawn:
+    return (pawnTargets<Us, GenType::Legal>(bitboards, masks, fromIndex) & to) ||
+           (state.enPassantIndex == toIndex && enPassantCapturers<Us>(state, squareBitboard(fromIndex)));
+  case PieceType::King:
+    return (kingAttacks(fromIndex) & to & ~state.attackMap(!Us)) ||
+           (castlingTargets<Us>(state, masks, fromIndex) & to);
+  default:
+    return legalTargets(masks, fromIndex, to);
+  }
+}
+
+template <PieceType Type>
+static bool hasPieceMove(const MoveMasks &masks, Bitboard pieces, const Bitboard occupied, const Bitboard targetMask)
+{
+  while (pieces)
+  {
+    const int fromIndex = popLsb(pieces);
+    if (legalTargets(masks, fromIndex, pieceAttacks<Type>(fromIndex, occupied) & targetMask))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Stops at the first legal move. The king goes first: it needs no pin or check masks, and when few moves
+// are left it usually has one. Castling can be skipped since it requires a legal king step to the passed square.
+template <PieceColor Us>
+static bool hasLegalMove(const GameState &state)
+{
+  const auto &bitboards = state.bitboards;
+  const auto pieces = [&](const PieceType type) { return bitboards.pieceBitboard(Us, type); };
+  const Bitboard notOwn = ~bitboards.colorBitboard(Us);
+
+  Bitboard king = pieces(PieceType::King);
+  while (king)
+  {
+    if (kingAttacks(popLsb(king)) & notOwn & ~state.attackMap(!Us))
+    {
+      return true;
+    }
+  }
+
+  const auto masks = computeMoveMasks<Us>(bitboards);
+  if (!masks.checkMask)
+  {
+    return false;
+  }
+
+  Bitboard pawns = pieces(PieceType::Pawn);
+  while (pawns)
+  {
+    if (pawnTargets<Us, GenType::Legal>(bitboards, masks, popLsb(pawns)))
+    {
+      return true;
+    }
+  }
+
+  const Bitboard occupied = bitboards.occupied;
+  return hasPieceMove<PieceType::Knight>(masks, pieces(PieceType::Knight), occupied, notOwn) ||
+         hasPieceMove<PieceType::Bishop>(masks, pieces(PieceType::Bishop), occupied, notOwn) ||
+         hasPieceMove<PieceType::Rook>(masks, pieces(PieceType::Rook), occupied, notOwn) ||
+         hasPieceMove<PieceType::Queen>(masks, pieces(PieceType::Queen), occupied, notOwn) ||
+         enPassantCapturers<Us>(state, pieces(PieceType::Pawn));
+}
+
+bool anyLegalMove(const GameState &state)
+{
+  return state.activeColor == PieceColor::White ? hasLegalMove<PieceColor::White>(state)
+                                                : hasLegalMove<PieceColor::Black>(state);
+}
+
+// Same-type pieces that reach toIndex are found by attacking from toIndex, so no other piece's moves are
+// generated; the candidates are then filtered by the pin and check masks. Pawns and kings never need it:
+// SAN always names the file of a pawn capture, and there is only one king.
+template <PieceColor Us>
+static Bitboard sameTypeMovers(const GameState &state, const int fromIndex, const int toIndex)
+{
+  const auto &bitboards = state.bitboards;
+  const auto type = pieceTypeOf(state.piecePlacement[fromIndex]);
+  const Bitboard others = bitboards.pieceBitboard(Us, type) & ~squareBitboard(fromIndex);
+  const Bitboard occupied = bitboards.occupied;
+
+  Bitboard candidates = 0;
+  switch (type)
+  {
+  case PieceType::Knight:
+    candidates = knightAttacks(toIndex) & others;
+    break;
+  case PieceType::Bishop:
+    candidates = bishopAttacks(toIndex, occupied) & others;
+    break;
+  case PieceType::Rook:
+    candidates = rookAttacks(toIndex, occupied) & others;
+    break;
+  case PieceType::Queen:
+    candidates = queenAttacks(toIndex, occupied) & others;
+    break;
+  case PieceType::Pawn:
+  case PieceType::King:
+    return 0;
+  }
+
+  if (!candidates)
+  {
+    return 0;
+  }
+
+  const auto masks = computeMoveMasks<Us>(bitboards);
+  Bitboard res = 0;
+  while (candidates)
+  {
+    const int candidateIndex = popLsb(candidates);
+    if (legalTargets(masks, candidateIndex, squareBitboard(toIndex)))
+    {
+      res |= squareBitboard(candidateIndex);
+    }
+  }
+
+  return res;
+}
+
+Bitboard ambiguousMovers(const GameState &state, const Square fromIndex, const Square toIndex)
+{
+  return getPieceColor(state.piecePlacement[fromIndex]) == PieceColor::White
+             ? sameTypeMovers<PieceColor::White>(state, fromIndex, toIndex)
+             : sameTypeMovers<PieceColor::Black>(state, fromIndex, toIndex);
+}
+
+bool isLegal(const GameState &state, const Square fromIndex, const Square toIndex)
+{
+  const auto piece = state.piecePlacement[fromIndex];
+  if (piece == ChessPiece::Empty)
+  {
+    return false;
+  }
+
+  return pieceColorOf(piece) == PieceColor::White ? isLegalMove<PieceColor::White>(state, fromIndex, toIndex)
+                                                   : isLegalMove<PieceColor::Black>(state, fromIndex, toIndex);
+}
+
+void generatePieceMoves(const GameState &state, const Square index, MoveList &moves)
+{
+  const auto piece = state.piecePlacement[index];
+  if (piece == ChessPiece::Empty)
+  {
+    throw std::invalid_argument("generatePieceMoves(): no piece at given index");
+  }
+
+  if (pieceColorOf(piece) == PieceColor::White)
+  {
+    generateSquare<PieceColor::White>(state, index, moves);
+  }
+  else
+  {
+    generateSquare<PieceColor::Black>(state, index, moves);
+  }
+}
+
+template <GenType Gen>
+void generateMoves(const GameState &state, MoveList &moves)
+{
+  moves.clear();
+
+  const bool isWhite = state.activeColor == PieceColor::White;
+  if constexpr (Gen == GenType::QuietChecks)
+  {
+    if (isWhite)
+    {
+      generateQuietChecks<PieceColor::White>(state, moves);
+    }
+    else
+    {
+      generateQuietChecks<PieceColor::Black>(state, moves);
+    }
+  }
+  else
+  {
+    if (isWhite)
+    {
+      generateAll<PieceColor::White, Gen>(state, moves);
+    }
+    else
+    {
+      generateAll<PieceColor::Black, Gen>(state, moves);
+    }
+  }
+}
+
+template void generateMoves<GenType::Captures>(const GameState &, MoveList &);
+template void generateMoves<GenType::Quiets>(const GameState &, MoveList &);
+template void generateMoves<GenType::Evasions>(const GameState &, MoveList &);
+template void generateMoves<GenType::QuietChecks>(const GameState &, MoveList &);
+template void generateMoves<GenType::Legal>(const GameState &, MoveList &);
+
+void generateLegalMoves(const GameState &state, MoveList &moves) { generateMoves<GenType::Legal>(state, moves); }
+
+bool givesCheck(const GameState &state, const Move move)
+{
+  const int fromIndex = move.fromIndex();
+  const int toIndex = move.toIndex();
+  const auto piece = state.piecePlacement[fromIndex];
+  const auto color = getPieceColor(piece);
+  const auto capturedPiece = state.piecePlacement[toIndex];
+
+  auto bitboards = state.bitboards;
+  bitboards.removePiece(fromIndex, piece);
+  if (capturedPiece != ChessPiece::Empty)
+  {
+    bitboards.removePiece(toIndex, capturedPiece);
+  }
+
+  switch (move.type())
+  {
+  case MoveType::Normal:
+    bitboards.addPiece(toIndex, piece);
+    break;
+  case MoveType::Promotion:
+    bitboards.addPiece(toIndex, makeChessPiece(color, move.promotionType()));
+    break;
+  case MoveType::EnPassant:
+    bitboards.addPiece(toIndex, piece);
+    bitboards.removePiece(toIndex + (color == PieceColor::White ? 8 : -8), makeChessPiece(!color, PieceType::Pawn));
+    break;
+  case MoveType::Castling:
+  {
+    const auto rook = makeChessPiece(color, PieceType::Rook);
+    const bool isShort = toIndex > fromIndex;
+    bitboards.addPiece(toIndex, piece);
+    bitboards.removePiece(isShort ? toIndex + 1 : toIndex - 2, rook);
+    bitboards.addPiece(isShort ? toIndex - 1 : toIndex + 1, rook);
+    break;
+  }
+  }
+
+  return isKingAttacked(!color, bitboards);
+}
+
+std::vector<BoardIndex> targetIndexes(const MoveList &moves)
+{
+  // the four promotions to a square are adjacent and count once
+  std::vector<BoardIndex> res;
+  res.reserve(moves.size());
+  for (const auto move : moves)
+  {
+    if (res.empty() || res.back() != move.toIndex())
+    {
+      res.emplace_back(move.toIndex());
+    }
+  }
+
+  return res;
+}
+
+std::vector<BoardIndex> legalTargetIndexes(const GameState &state, const Square index)
+{
+  MoveList moves;
+  generatePieceMoves(state, index, moves);
+  return targetIndexes(moves);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "bitboard.hpp"
+#include "gameState.hpp"
+#include "move.hpp"
+#include "types.hpp"
+
+// whether a piece of attackerColor = !defenderColor attacks index
+bool isSquareAttacked(const int index, const PieceColor defenderColor, const Bitboards &);
+
+// false when the side has no king on the board
+bool isKingAttacked(const PieceColor, const Bitboards &);
+
+// Stages of legal move generation for the side to move. Captures includes every promotion and en
+// passant, Quiets the remaining moves (castling too), so the two together equal Legal. Evasions is
+// empty unless the side to move is in check, and QuietChecks is the subset of Quiets giving check.
+enum class GenType
+{
+  Captures,
+  Quiets,
+  Evasions,
+  QuietChecks,
+  Legal,
+};
+
+// replaces the contents of the list with the legal moves of the given stage
+template <GenType>
+void generateMoves(const GameState &, MoveList &);
+
+void generateLegalMoves(const GameState &, MoveList &);
+
+// whether the side to move has a legal move, without generating the others; false on mate and stalemate
+bool anyLegalMove(const GameState &);
+
+// whether the move, legal for the side to move, attacks the opposing king
+bool givesCheck(const GameState &, const Move);
+
+// whether the piece on fromIndex, whichever side it belongs to, may legally move to toIndex
+bool isLegal(const GameState &, const Square fromIndex, const Square toIndex);
+
+// other pieces of the same color and type as the one on fromIndex that could legally move to toIndex too,
+// i.e. whether and how SAN has to disambiguate the move; always 0 for pawns and kings
+Bitboard ambiguousMovers(const GameState &, const Square fromIndex, const Square toIndex);
+
+// appends the legal moves of the piece on index, whichever side it belongs to; throws on an empty square
+void generatePieceMoves(const GameState &, const Square, MoveList &);
+
+// destination squares of one piece's moves, in generation order; the four promotions to a square count once
+std::vector<BoardIndex> targetIndexes(const MoveList &);
+
+// destination squares of the piece on index, see targetIndexes()
+std::vector<BoardIndex> legalTargetIndexes(const GameState &, const Square);
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <optional>
+#include <stddef.h>
+#include <stdexcept>
+
+#include "bitboard.hpp"
+#include "gameState.hpp"
+#include "packedState.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+PackedState PackedState::fromGameState(const GameState &state)
+{
+  const auto &bitboards = state.bitboards;
+  if (popCount(bitboards.occupied) > 32)
+  {
+    throw std::invalid_argument("PackedState::fromGameState(): more than 32 pieces");
+  }
+  if (state.halfmoveClock < 0 || state.halfmoveClock > UINT16_MAX)
+  {
+    throw std::invalid_argument("PackedState::fromGameState(): halfmove clock out of range");
+  }
+  if (state.fullmoveClock < 0 || state.fullmoveClock > UINT16_MAX)
+  {
+    throw std::invalid_argument("PackedState::fromGameState(): fullmove clock out of range");
+  }
+
+  PackedState res;
+  res.occupied = bitboards.occupied;
+  res.halfmoveClock = static_cast<uint16_t>(state.halfmoveClock);
+  res.fullmoveClock = static_cast<uint16_t>(state.fullmoveClock);
+
+  const auto &castling = state.castlingAvailability;
+  res.flags = (state.activeColor == PieceColor::Black) | castling.whiteShort << 1 | castling.whiteLong << 2 |
+              castling.blackShort << 3 | castling.blackLong << 4;
+  if (state.enPassantIndex.has_value())
+  {
+    res.enPassantIndex = static_cast<uint8_t>(state.enPassantIndex.value());
+  }
+
+  Bitboard occupied = bitboards.occupied;
+  for (size_t i = 0; occupied; ++i)
+  {
+    const auto piece = state.piecePlacement[popLsb(occupied)];
+    const auto code = colorIndex(pieceColorOf(piece)) * 6 + static_cast<size_t>(pieceTypeOf(piece));
+    res.pieces[i / 2] |= code << (i % 2 * 4);
+  }
+
+  return res;
+}
+
+GameState PackedState::toGameState() const
+{
+  GameState res;
+  res.piecePlacement.fill(ChessPiece::Empty);
+
+  Bitboard remaining = occupied;
+  for (size_t i = 0; remaining; ++i)
+  {
+    const int code = (pieces[i / 2] >> (i % 2 * 4)) & 0xF;
+    const auto color = code < 6 ? PieceColor::White : PieceColor::Black;
+    res.piecePlacement[popLsb(remaining)] = makeChessPiece(color, static_cast<PieceType>(code % 6));
+  }
+
+  res.activeColor = flags & 1 ? PieceColor::Black : PieceColor::White;
+  res.castlingAvailability = {
+      static_cast<bool>(flags & 2),
+      static_cast<bool>(flags & 4),
+      static_cast<bool>(flags & 8),
+      static_cast<bool>(flags & 16)};
+  res.enPassantIndex = enPassantIndex == 0xFF ? std::nullopt : std::optional<Square>{enPassantIndex};
+  res.halfmoveClock = halfmoveClock;
+  res.fullmoveClock = fullmoveClock;
+  res.syncBitboards();
+
+  return res;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "bitboard.hpp"
+#include "gameState.hpp"
+
+// Canonical 32-byte encoding of a GameState, for snapshots and storage. Pieces are stored as one nibble per
+// occupied square in index order, so equal positions always encode to equal bytes. Move history is not kept.
+struct PackedState
+{
+  Bitboard occupied = 0;
+  std::array<uint8_t, 16> pieces{}; // colorIndex * 6 + piece type, low nibble first
+  uint16_t halfmoveClock = 0;
+  uint16_t fullmoveClock = 0;
+  uint8_t flags = 0;             // bit 0: black to move, bits 1-4: castling rights as in CastlingAvailability
+  uint8_t enPassantIndex = 0xFF; // 0xFF when there is none
+  uint16_t reserved = 0;         // zero; spells out what would be padding so the bytes can be compared or stored
+
+  // throws std::invalid_argument for more than 32 pieces or a clock beyond 16 bits
+  static PackedState fromGameState(const GameState &);
+  GameState toGameState() const;
+
+  bool operator==(const PackedState &other) const
+  {
+    return (
+        occupied == other.occupied && pieces == other.pieces && halfmoveClock == other.halfmoveClock &&
+        fullmoveClock == other.fullmoveClock && flags == other.flags && enPassantIndex == other.enPassantIndex &&
+        reserved == other.reserved);
+  }
+};
+
+static_assert(sizeof(PackedState) == 32);
+static_assert(std::has_unique_object_representations_v<PackedState>);
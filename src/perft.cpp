@@ -0,0 +1,148 @@
+#include "perft.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gameState.hpp"
+#include "move.hpp"
+#include "movegen.hpp"
+
+PerftTable::PerftTable(const size_t megabytes)
+{
+  const size_t maxEntries = megabytes * 1024 * 1024 / sizeof(Entry);
+  if (maxEntries == 0)
+  {
+    throw std::invalid_argument("PerftTable(): size must be at least 1 MB");
+  }
+
+  size_t entryCount = 1;
+  while (entryCount * 2 <= maxEntries)
+  {
+    entryCount *= 2;
+  }
+  entries = std::make_unique<Entry[]>(entryCount);
+  indexMask = entryCount - 1;
+}
+
+std::optional<uint64_t> PerftTable::probe(const uint64_t key, const int depth) const
+{
+  const auto &entry = entries[key & indexMask];
+  const uint64_t data = entry.data.load(std::memory_order_relaxed);
+  const uint64_t check = entry.check.load(std::memory_order_relaxed);
+  if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth)
+  {
+    return std::nullopt;
+  }
+  return data >> 8;
+}
+
+void PerftTable::store(const uint64_t key, const int depth, const uint64_t nodes)
+{
+  auto &entry = entries[key & indexMask];
+  const uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+  entry.check.store(key ^ data, std::memory_order_relaxed);
+  entry.data.store(data, std::memory_order_relaxed);
+}
+
+uint64_t perft(GameState &state, const int depth) { return perft(state, depth, nullptr); }
+
+uint64_t perft(GameState &state, const int depth, PerftTable *table)
+{
+  if (depth < 0)
+  {
+    throw std::invalid_argument("perft(): depth must not be negative");
+  }
+  if (depth == 0)
+  {
+    return 1;
+  }
+
+  MoveList moves;
+  generateLegalMoves(state, moves);
+  if (depth == 1)
+  {
+    return moves.size();
+  }
+
+  // depth 1 is cheaper to recount than to look up
+  const uint64_t key = state.zobristKey;
+  if (table)
+  {
+    if (const auto nodes = table->probe(key, depth))
+    {
+      return *nodes;
+    }
+  }
+
+  uint64_t nodes = 0;
+  for (const auto move : moves)
+  {
+    state.makeMove(move);
+    nodes += perft(state, depth - 1, table);
+    state.unmakeMove();
+  }
+
+  if (table)
+  {
+    table->store(key, depth, nodes);
+  }
+  return nodes;
+}
+
+std::vector<std::pair<Move, uint64_t>> perftDivide(GameState &state, const int depth)
+{
+  return perftDivide(state, depth, 1, nullptr);
+}
+
+std::vector<std::pair<Move, uint64_t>> perftDivide(
+    const GameState &state, const int depth, const unsigned threadCount, PerftTable *table)
+{
+  if (depth < 1)
+  {
+    throw std::invalid_argument("perftDivide(): depth must be at least 1");
+  }
+  if (threadCount == 0)
+  {
+    throw std::invalid_argument("perftDivide(): threadCount must be at least 1");
+  }
+
+  MoveList moves;
+  generateLegalMoves(state, moves);
+
+  std::vector<std::pair<Move, uint64_t>> res;
+  res.reserve(moves.size());
+  for (const auto move : moves)
+  {
+    res.emplace_back(move, 0);
+  }
+
+  std::atomic<size_t> nextMove{0};
+  const auto work = [&]()
+  {
+    auto copy = state;
+    for (size_t i = nextMove++; i < res.size(); i = nextMove++)
+    {
+      copy.makeMove(res[i].first);
+      res[i].second = perft(copy, depth - 1, table);
+      copy.unmakeMove();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < threadCount; ++i)
+  {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  return res;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+#include "gameState.hpp"
+#include "move.hpp"
+
+// Subtree counts keyed by position hash and remaining depth, shared between perft threads without locks.
+// Each slot stores key ^ data next to data, so a slot torn by two racing writers fails the key check on
+// probe and reads as a miss instead of a wrong count.
+class PerftTable
+{
+public:
+  // the slot count is the largest power of two that fits in the given size
+  explicit PerftTable(const size_t megabytes);
+
+  std::optional<uint64_t> probe(const uint64_t key, const int depth) const;
+  void store(const uint64_t key, const int depth, const uint64_t nodes);
+
+private:
+  struct Entry
+  {
+    std::atomic<uint64_t> check{0};
+    std::atomic<uint64_t> data{0}; // nodes << 8 | depth
+  };
+
+  std::unique_ptr<Entry[]> entries;
+  size_t indexMask = 0;
+};
+
+// Leaf nodes of the legal move tree at the given depth. The last ply is bulk counted from the size of
+// the move list, so leaves are never played. The state is walked with makeMove/unmakeMove and is left
+// unchanged.
+uint64_t perft(GameState &, const int depth);
+uint64_t perft(GameState &, const int depth, PerftTable *);
+
+// perft split by root move, in generation order
+std::vector<std::pair<Move, uint64_t>> perftDivide(GameState &, const int depth);
+
+// Root moves are handed out one at a time to threadCount workers, each searching its own copy of the
+// state. The table, if any, is shared by all of them.
+std::vector<std::pair<Move, uint64_t>> perftDivide(
+    const GameState &, const int depth, const unsigned threadCount, PerftTable *);
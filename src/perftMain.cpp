@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "gameState.hpp"
+#include "move.hpp"
+#include "perft.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+// long algebraic notation, e.g. e2e4 or e7e8q
+static std::string moveToString(const Move move)
+{
+  static const char promotionChars[] = {'n', 'b', 'r', 'q'};
+
+  std::string res = indexToAlgebraic(move.fromIndex()) + indexToAlgebraic(move.toIndex());
+  if (move.type() == MoveType::Promotion)
+  {
+    res += promotionChars[static_cast<int>(move.promotionType()) - static_cast<int>(PieceType::Knight)];
+  }
+
+  return res;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3 || argc > 5)
+  {
+    std::cerr << "usage: perft \"<fen>\" <depth> [threads] [hash MB]\n";
+    return 1;
+  }
+
+  GameState state;
+  int depth;
+  unsigned threadCount = 1;
+  std::unique_ptr<PerftTable> table;
+  try
+  {
+    state = GameState::fromFEN(argv[1]);
+    depth = std::stoi(argv[2]);
+    if (depth < 1)
+    {
+      throw std::invalid_argument("depth must be at least 1");
+    }
+    if (argc > 3)
+    {
+      const int threads = std::stoi(argv[3]);
+      if (threads < 1)
+      {
+        throw std::invalid_argument("threads must be at least 1");
+      }
+      threadCount = threads;
+    }
+    if (argc > 4)
+    {
+      const int megabytes = std::stoi(argv[4]);
+      if (megabytes < 0)
+      {
+        throw std::invalid_argument("hash size must not be negative");
+      }
+      if (megabytes > 0)
+      {
+        table = std::make_unique<PerftTable>(megabytes);
+      }
+    }
+  }
+  catch (std::exception &e)
+  {
+    std::cerr << "invalid arguments: " << e.what() << "\n";
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto divide = perftDivide(state, depth, threadCount, table.get());
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  uint64_t nodes = 0;
+  for (const auto &[move, count] : divide)
+  {
+    std::cout << moveToString(move) << ": " << count << "\n";
+    nodes += count;
+  }
+
+  std::cout << "\nNodes searched: " << nodes << "\n";
+  std::cout << "Time: " << static_cast<uint64_t>(elapsed * 1000) << " ms\n";
+  std::cout << "NPS: " << static_cast<uint64_t>(elapsed > 0 ? nodes / elapsed : 0) << "\n";
+
+  return 0;
+}
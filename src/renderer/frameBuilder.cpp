@@ -4,8 +4,10 @@
 #include <unistd.h>
 #include <vector>
 
+#include "../constants.hpp"
 #include "../game.hpp"
 #include "../logger.hpp"
+#include "../move.hpp"
 #include "../pgn.hpp"
 #include "../utils.hpp"
 #include "config.hpp"
@@ -155,100 +157,60 @@ std::vector<std::string> FrameBuilder::makeGameBoardLines(const int squareWidth,
 std::vector<std::string> FrameBuilder::makeMoveListEntries()
 {
   std::vector<std::string> res;
+  res.reserve(game.moveList.size());
 
   for (auto it = game.moveList.cbegin(); it != game.moveList.cend(); ++it)
   {
-    const auto moveListItem = *it;
+    const auto &record = *it;
+    const auto move = record.move;
     std::stringstream item;
 
-    const auto fromIndex = moveListItem.fromIndex;
-    const auto fromPiece = moveListItem.fromPiece;
-
-    const bool isPawn = fromPiece == ChessPiece::BlackPawn || fromPiece == ChessPiece::WhitePawn;
-    const bool isCapture = moveListItem.toPiece != ChessPiece::Empty || moveListItem.isEnPassantCapture;
-    const bool isPromotion = moveListItem.promotionPiece != ChessPiece::Empty;
-    const bool isOpponentInCheck = moveListItem.isOpponentInCheck;
-
-    if (!moveListItem.castlingString.empty())
+    if (move.type() == MoveType::Castling)
     {
-      res.push_back(moveListItem.castlingString);
-      continue;
+      item << (move.toIndex() > move.fromIndex() ? shortCastleString : longCastleString);
     }
-
-    if (!isPawn)
+    else
     {
-      const char piece = std::toupper(chessPieceToChar(moveListItem.fromPiece));
-      item << piece;
-      if (!moveListItem.samePieceIndexes.empty())
+      const bool isPawn = getPieceType(record.piece) == PieceType::Pawn;
+      const auto fromSquare = indexToAlgebraic(move.fromIndex());
+
+      if (!isPawn)
       {
-        item << handleAmbiguousMove(fromIndex, moveListItem.samePieceIndexes);
+        item << chessPieceToChar(makeChessPiece(PieceColor::White, getPieceType(record.piece)));
+        if (record.has(MoveRecord::FileNeeded))
+        {
+          item << fromSquare[0];
+        }
+        if (record.has(MoveRecord::RankNeeded))
+        {
+          item << fromSquare[1];
+        }
       }
-    }
 
-    if (isCapture)
-    {
-      if (isPawn)
+      if (record.has(MoveRecord::Capture))
       {
-        item << indexToAlgebraic(moveListItem.fromIndex)[0];
+        if (isPawn)
+        {
+          item << fromSquare[0];
+        }
+        item << 'x';
       }
-      item << 'x';
-    }
 
-    item << indexToAlgebraic(moveListItem.toIndex);
-
-    if (isPromotion)
-    {
-      const char promotionChar = std::toupper(chessPieceToChar(moveListItem.promotionPiece));
-      item << '=' << promotionChar;
-    }
-
-    if (isOpponentInCheck)
-    {
-      char c = '+';
+      item << indexToAlgebraic(move.toIndex());
 
-      const auto lastEntry = it == --game.moveList.cend();
-      if (lastEntry && game.isGameOver == true)
+      if (move.type() == MoveType::Promotion)
       {
-        c = '#';
+        item << '=' << chessPieceToChar(makeChessPiece(PieceColor::White, move.promotionType()));
       }
-
-      item << c;
     }
 
-    res.push_back(item.str());
-  }
-
-  return res;
-}
-
-std::string FrameBuilder::handleAmbiguousMove(BoardIndex fromIndex, std::vector<BoardIndex> otherIndexes)
-{
-  const auto [pieceFile, pieceRank] = indexToFileRank(fromIndex);
-  bool isSameFile = false;
-  bool isSameRank = false;
-
-  for (auto &otherIdx : otherIndexes)
-  {
-    const auto [otherFile, otherRank] = indexToFileRank(otherIdx);
-    if (otherFile == pieceFile)
-    {
-      isSameFile = true;
-    }
-    if (otherRank == pieceRank)
+    if (record.has(MoveRecord::Check))
     {
-      isSameRank = true;
+      const auto lastEntry = it == --game.moveList.cend();
+      item << (lastEntry && game.isGameOver ? '#' : '+');
     }
-  }
 
-  std::string res;
-  const auto pieceSquare = indexToAlgebraic(fromIndex);
-  if (isSameRank)
-  {
-    res += pieceSquare[0];
-  }
-  if (isSameFile)
-  {
-    res += pieceSquare[1];
+    res.push_back(item.str());
   }
 
   return res;
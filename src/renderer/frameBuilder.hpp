@@ -22,7 +22,6 @@ private:
 
   std::vector<std::string> makeGameBoardLines(const int squareWidth, const int squareHeight);
   std::vector<std::string> makeMoveListEntries();
-  std::string handleAmbiguousMove(BoardIndex fromIndex, std::vector<BoardIndex> otherIndexes);
   std::vector<std::string> makeMoveListLines(
       const std::vector<std::string> &moveListEntries,
       const size_t moveListLength,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
@@ -13,7 +14,7 @@ enum class PieceColor : char
 
 };
 
-inline PieceColor operator!(const PieceColor current)
+constexpr PieceColor operator!(const PieceColor current)
 {
   return (current == PieceColor::White) ? PieceColor::Black : PieceColor::White;
 }
@@ -35,6 +36,16 @@ enum class ChessPiece : char
   Empty = '\0',
 };
 
+enum class PieceType : char
+{
+  Pawn,
+  Knight,
+  Bishop,
+  Rook,
+  Queen,
+  King,
+};
+
 using PiecePlacement = std::array<ChessPiece, 64>;
 
 struct CastlingAvailability
@@ -121,23 +132,27 @@ public:
   }
 };
 
-class FileRankIndex : public RangedInt
+// Board index for engine internals: one byte, trivially copyable and unchecked. BoardIndex does the range
+// checks where indexes enter from user input or FEN.
+class Square
 {
 public:
-  FileRankIndex() : RangedInt(1, 1, 8) {}
+  constexpr Square() = default;
+  constexpr Square(const int v) : val(static_cast<uint8_t>(v)) {}
+  Square(const BoardIndex index) : val(static_cast<uint8_t>(static_cast<int>(index))) {}
 
-  FileRankIndex(int v) : RangedInt(v, 1, 8) {}
+  constexpr operator int() const { return val; }
+
+private:
+  uint8_t val = 0;
 };
 
-struct MoveListItem
+static_assert(sizeof(Square) == 1);
+
+class FileRankIndex : public RangedInt
 {
-  BoardIndex fromIndex;
-  ChessPiece fromPiece;
-  BoardIndex toIndex;
-  ChessPiece toPiece;
-  std::vector<BoardIndex> samePieceIndexes;
-  ChessPiece promotionPiece;
-  std::string castlingString;
-  bool isOpponentInCheck;
-  bool isEnPassantCapture;
+public:
+  FileRankIndex() : RangedInt(1, 1, 8) {}
+
+  FileRankIndex(int v) : RangedInt(v, 1, 8) {}
 };
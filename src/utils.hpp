@@ -1,12 +1,11 @@
 #pragma once
 
+#include <array>
 #include <cctype>
 #include <optional>
-#include <set>
 #include <stddef.h>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
 
 #include "types.hpp"
 
@@ -18,11 +17,37 @@ struct FileRank
   bool operator==(const FileRank &fr) const { return file == fr.file && rank == fr.rank; }
 };
 
-inline bool isChessPiece(const char c)
+// Piece letters in PieceType order, indexed by static_cast<size_t>(PieceType).
+inline constexpr char whitePieceChars[] = "PNBRQK";
+inline constexpr char blackPieceChars[] = "pnbrqk";
+
+struct PieceTraits
 {
-  static const std::set<char> chessPieces{'p', 'r', 'n', 'b', 'k', 'q', 'P', 'R', 'N', 'B', 'K', 'Q'};
-  return chessPieces.find(c) != chessPieces.end();
-}
+  ChessPiece piece = ChessPiece::Empty; // Empty for chars that are not pieces
+  PieceColor color = PieceColor::White;
+  PieceType type = PieceType::Pawn;
+};
+
+// One entry per char value, so every piece lookup below is a single table read that cannot fail. Only
+// charToChessPiece(), where text enters, reports chars that are not pieces.
+inline constexpr std::array<PieceTraits, 256> pieceTraits = []()
+{
+  std::array<PieceTraits, 256> res{};
+  for (size_t type = 0; type < 6; ++type)
+  {
+    const char white = whitePieceChars[type];
+    const char black = blackPieceChars[type];
+    res[static_cast<unsigned char>(white)] = {
+        static_cast<ChessPiece>(white), PieceColor::White, static_cast<PieceType>(type)};
+    res[static_cast<unsigned char>(black)] = {
+        static_cast<ChessPiece>(black), PieceColor::Black, static_cast<PieceType>(type)};
+  }
+  return res;
+}();
+
+constexpr const PieceTraits &pieceTraitsOf(const char c) { return pieceTraits[static_cast<unsigned char>(c)]; }
+
+constexpr bool isChessPiece(const char c) { return pieceTraitsOf(c).piece != ChessPiece::Empty; }
 
 inline char colorToChar(const PieceColor color) { return static_cast<char>(color); }
 
@@ -41,7 +66,7 @@ inline PieceColor charToColor(const char c)
   throw std::invalid_argument("Argument is not a chess piece color.");
 }
 
-inline char chessPieceToChar(const ChessPiece piece) { return static_cast<char>(piece); }
+constexpr char chessPieceToChar(const ChessPiece piece) { return static_cast<char>(piece); }
 
 inline ChessPiece charToChessPiece(const char c)
 {
@@ -50,33 +75,38 @@ inline ChessPiece charToChessPiece(const char c)
     throw std::invalid_argument("Argument is not a chess piece.");
   }
 
-  static const std::unordered_map<char, ChessPiece> pieceMap = {
-      {'p', ChessPiece::BlackPawn},
-      {'n', ChessPiece::BlackKnight},
-      {'b', ChessPiece::BlackBishop},
-      {'r', ChessPiece::BlackRook},
-      {'q', ChessPiece::BlackQueen},
-      {'k', ChessPiece::BlackKing},
-      {'P', ChessPiece::WhitePawn},
-      {'N', ChessPiece::WhiteKnight},
-      {'B', ChessPiece::WhiteBishop},
-      {'R', ChessPiece::WhiteRook},
-      {'Q', ChessPiece::WhiteQueen},
-      {'K', ChessPiece::WhiteKing},
-  };
+  return pieceTraitsOf(c).piece;
+}
+
+// Unchecked lookups for engine code that only reads occupied squares. Empty is not caught and reads as a
+// white pawn, so anything that may see an empty square uses getPieceColor()/getPieceType() instead.
+constexpr PieceColor pieceColorOf(const ChessPiece piece) { return pieceTraitsOf(chessPieceToChar(piece)).color; }
+constexpr PieceType pieceTypeOf(const ChessPiece piece) { return pieceTraitsOf(chessPieceToChar(piece)).type; }
+
+constexpr PieceColor getPieceColor(const ChessPiece piece)
+{
+  if (piece == ChessPiece::Empty)
+  {
+    throw std::invalid_argument("getPieceColor(): input is an empty piece");
+  }
 
-  return pieceMap.at(c);
+  return pieceColorOf(piece);
 }
 
-inline PieceColor getPieceColor(const ChessPiece piece)
+constexpr PieceType getPieceType(const ChessPiece piece)
 {
   if (piece == ChessPiece::Empty)
   {
-    throw std::invalid_argument("pieceColor: input is an empty piece");
+    throw std::invalid_argument("getPieceType(): input is an empty piece");
   }
 
-  const char cChar = chessPieceToChar(piece);
-  return ((std::tolower(cChar) == cChar) ? PieceColor::Black : PieceColor::White);
+  return pieceTypeOf(piece);
+}
+
+constexpr ChessPiece makeChessPiece(const PieceColor color, const PieceType type)
+{
+  const auto &chars = color == PieceColor::White ? whitePieceChars : blackPieceChars;
+  return static_cast<ChessPiece>(chars[static_cast<size_t>(type)]);
 }
 
 inline BoardIndex algebraicToIndex(const std::string &algebraicSquare)
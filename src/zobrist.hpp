@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "bitboard.hpp"
+#include "types.hpp"
+#include "utils.hpp"
+
+namespace zobrist
+{
+struct Keys
+{
+  std::array<std::array<std::array<uint64_t, 64>, 6>, 2> pieces{};
+  std::array<uint64_t, 4> castling{}; // white short, white long, black short, black long
+  std::array<uint64_t, 8> enPassantFile{};
+  uint64_t blackToMove = 0;
+};
+
+// splitmix64, so the keys are fixed at compile time and identical across builds
+constexpr uint64_t nextRandom(uint64_t &seed)
+{
+  uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+constexpr Keys makeKeys()
+{
+  Keys keys;
+  uint64_t seed = 0x2545F4914F6CDD1DULL;
+  for (auto &color : keys.pieces)
+  {
+    for (auto &type : color)
+    {
+      for (auto &key : type)
+      {
+        key = nextRandom(seed);
+      }
+    }
+  }
+  for (auto &key : keys.castling)
+  {
+    key = nextRandom(seed);
+  }
+  for (auto &key : keys.enPassantFile)
+  {
+    key = nextRandom(seed);
+  }
+  keys.blackToMove = nextRandom(seed);
+  return keys;
+}
+
+inline constexpr Keys keys = makeKeys();
+
+inline uint64_t pieceKey(const ChessPiece piece, const int index)
+{
+  return keys.pieces[colorIndex(pieceColorOf(piece))][static_cast<size_t>(pieceTypeOf(piece))][index];
+}
+
+inline uint64_t castlingKey(const CastlingAvailability &castlingAvailability)
+{
+  uint64_t key = 0;
+  key ^= castlingAvailability.whiteShort ? keys.castling[0] : 0;
+  key ^= castlingAvailability.whiteLong ? keys.castling[1] : 0;
+  key ^= castlingAvailability.blackShort ? keys.castling[2] : 0;
+  key ^= castlingAvailability.blackLong ? keys.castling[3] : 0;
+  return key;
+}
+
+inline uint64_t enPassantKey(const std::optional<Square> &enPassantIndex)
+{
+  return enPassantIndex.has_value() ? keys.enPassantFile[enPassantIndex.value() % 8] : 0;
+}
+} // namespace zobrist
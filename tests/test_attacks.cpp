@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../src/attacks.hpp"
+#include "../src/bitboard.hpp"
+
+static const std::vector<std::pair<int, int>> diagonalOffsets = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+static const std::vector<std::pair<int, int>> orthogonalOffsets = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+TEST(SliderAttacksTest, EmptyBoard)
+{
+  ASSERT_EQ(popCount(rookAttacks(56, 0)), 14);   // a1
+  ASSERT_EQ(popCount(bishopAttacks(56, 0)), 7);  // a1
+  ASSERT_EQ(popCount(bishopAttacks(27, 0)), 13); // d5
+  ASSERT_EQ(popCount(queenAttacks(27, 0)), 27);  // d5
+}
+
+TEST(SliderAttacksTest, StopsAtFirstBlocker)
+{
+  // rook on d4 with blockers on d6 and f4: d5, d6, e4, f4 plus the open rays
+  const Bitboard occupied = squareBitboard(19) | squareBitboard(37);
+  const Bitboard expected = squareBitboard(27) | squareBitboard(19) | squareBitboard(36) | squareBitboard(37) |
+                            squareBitboard(34) | squareBitboard(33) | squareBitboard(32) | squareBitboard(43) |
+                            squareBitboard(51) | squareBitboard(59);
+  ASSERT_EQ(rookAttacks(35, occupied), expected);
+}
+
+TEST(SliderAttacksTest, MatchesRayWalk)
+{
+  uint64_t s = 0x9E3779B97F4A7C15ULL;
+  for (int i = 0; i < 2000; ++i)
+  {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    const Bitboard occupied = s & (s >> 3);
+
+    for (int index = 0; index < 64; ++index)
+    {
+      ASSERT_EQ(bishopAttacks(index, occupied), slidingAttacks(index, diagonalOffsets, occupied));
+      ASSERT_EQ(rookAttacks(index, occupied), slidingAttacks(index, orthogonalOffsets, occupied));
+    }
+  }
+}
+
+TEST(StepAttacksTest, Tables)
+{
+  ASSERT_EQ(knightAttacks(56), squareBitboard(41) | squareBitboard(50));                  // a1 -> b3, c2
+  ASSERT_EQ(popCount(knightAttacks(27)), 8);                                              // d5
+  ASSERT_EQ(kingAttacks(0), squareBitboard(1) | squareBitboard(8) | squareBitboard(9));   // a8
+  ASSERT_EQ(popCount(kingAttacks(36)), 8);                                                // e4
+  ASSERT_EQ(pawnAttacks(PieceColor::White, 52), squareBitboard(43) | squareBitboard(45)); // e2 -> d3, f3
+  ASSERT_EQ(pawnAttacks(PieceColor::Black, 8), squareBitboard(17));                       // a7 -> b6
+  ASSERT_EQ(pawnAttacks(PieceColor::White, 0), 0);                                        // a8
+}
+
+TEST(LineTablesTest, BetweenAndLine)
+{
+  ASSERT_EQ(betweenBitboard(56, 63), rank1Bitboard & ~(squareBitboard(56) | squareBitboard(63)));
+  ASSERT_EQ(betweenBitboard(0, 9), 0);
+  ASSERT_EQ(betweenBitboard(0, 10), 0);
+  ASSERT_EQ(lineBitboard(0, 63), lineBitboard(9, 18));
+  ASSERT_EQ(popCount(lineBitboard(0, 63)), 8);
+  ASSERT_EQ(lineBitboard(0, 10), 0);
+}
+
+TEST(PieceAttacksTest, MatchesPerPieceFunctions)
+{
+  const Bitboard occupied = squareBitboard(19) | squareBitboard(30) | squareBitboard(45);
+  ASSERT_EQ(pieceAttacks<PieceType::Knight>(27, occupied), knightAttacks(27));
+  ASSERT_EQ(pieceAttacks<PieceType::Bishop>(27, occupied), bishopAttacks(27, occupied));
+  ASSERT_EQ(pieceAttacks<PieceType::Rook>(27, occupied), rookAttacks(27, occupied));
+  ASSERT_EQ(pieceAttacks<PieceType::Queen>(27, occupied), queenAttacks(27, occupied));
+  ASSERT_EQ(pieceAttacks<PieceType::King>(27, occupied), kingAttacks(27));
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../src/bitboard.hpp"
+#include "../src/constants.hpp"
+#include "../src/gameState.hpp"
+#include "../src/types.hpp"
+
+TEST(ShiftBitboardTest, StaysOnBoard)
+{
+  // a-file squares cannot move further west, h-file squares cannot move further east
+  ASSERT_EQ(shiftBitboard(fileABitboard, -1, 0), 0);
+  ASSERT_EQ(shiftBitboard(fileHBitboard, 1, 0), 0);
+  ASSERT_EQ(shiftBitboard(rank8Bitboard, 0, 1), 0);
+  ASSERT_EQ(shiftBitboard(rank1Bitboard, 0, -1), 0);
+
+  ASSERT_EQ(shiftBitboard(squareBitboard(36), 1, 2), squareBitboard(21));  // e4 -> f6
+  ASSERT_EQ(shiftBitboard(squareBitboard(57), -2, 1), 0);                  // b1 -> off board
+  ASSERT_EQ(shiftBitboard(squareBitboard(57), 2, 1), squareBitboard(51)); // b1 -> d2
+}
+
+TEST(BitboardToIndexesTest, ValidInput)
+{
+  const auto expected = BoardIndex::create_vector({0, 27, 63});
+  ASSERT_EQ(bitboardToIndexes(squareBitboard(0) | squareBitboard(27) | squareBitboard(63)), expected);
+  ASSERT_TRUE(bitboardToIndexes(0).empty());
+}
+
+TEST(BitboardsTest, FromStartingPiecePlacement)
+{
+  const auto bitboards = Bitboards::fromPiecePlacement(startingPiecePlacement);
+
+  ASSERT_EQ(bitboards.colorBitboard(PieceColor::Black), rank8Bitboard | rank7Bitboard);
+  ASSERT_EQ(bitboards.colorBitboard(PieceColor::White), rank2Bitboard | rank1Bitboard);
+  ASSERT_EQ(bitboards.pieceBitboard(PieceColor::White, PieceType::Pawn), rank2Bitboard);
+  ASSERT_EQ(bitboards.pieceBitboard(PieceColor::Black, PieceType::King), squareBitboard(4));
+  ASSERT_EQ(bitboards.pieceBitboard(PieceColor::White, PieceType::Rook), squareBitboard(56) | squareBitboard(63));
+  ASSERT_EQ(popCount(bitboards.occupied), 32);
+}
+
+TEST(BitboardsTest, GameStateKeepsBitboardsInSync)
+{
+  auto state = GameState::fromFEN("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+  ASSERT_EQ(state.bitboards, Bitboards::fromPiecePlacement(state.piecePlacement));
+
+  state.clearSquare(60);
+  state.placePiece(62, ChessPiece::WhiteKing);
+  state.placePiece(0, ChessPiece::WhiteRook); // capture
+  ASSERT_EQ(state.bitboards, Bitboards::fromPiecePlacement(state.piecePlacement));
+  ASSERT_EQ(state.bitboards.pieceBitboard(PieceColor::Black, PieceType::Rook), squareBitboard(7));
+}
+
+TEST(BitboardsTest, AttackMapFollowsBoardWrites)
+{
+  auto state = GameState::fromFEN("8/8/8/8/4k3/8/8/K3R3 w - - 0 1");
+  ASSERT_TRUE(state.isInCheck(PieceColor::Black));
+  ASSERT_TRUE(state.attackMap(PieceColor::White) & squareBitboard(28)); // e5, behind the king
+
+  state.placePiece(52, ChessPiece::BlackPawn); // e2 blocks the file
+  ASSERT_FALSE(state.isInCheck(PieceColor::Black));
+  ASSERT_FALSE(state.attackMap(PieceColor::White) & squareBitboard(28));
+  ASSERT_TRUE(state.attackMap(PieceColor::Black) & squareBitboard(61)); // f1
+}
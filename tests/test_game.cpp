@@ -7,7 +7,7 @@
 #include "../src/config.hpp"
 #include "../src/constants.hpp"
 #include "../src/game.hpp"
-#include "../src/positionHash.hpp"
+#include "../src/movegen.hpp"
 
 // public methods
 
@@ -52,47 +52,169 @@ TEST(GameStateInitialization, FromMidGameFen)
   ASSERT_EQ(actual, expected);
 }
 
-TEST(GameGetPieceLegalMoves, InvokesCorrectPieceClass)
+TEST(GameStateMakeMove, CastlingUpdatesRookAndRights)
+{
+  auto state = Game::GameState::fromFEN("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 3 10");
+  const auto before = state;
+
+  state.makeMove(Move(60, 62, MoveType::Castling));
+  ASSERT_EQ(state.piecePlacement[62], ChessPiece::WhiteKing);
+  ASSERT_EQ(state.piecePlacement[61], ChessPiece::WhiteRook);
+  ASSERT_EQ(state.piecePlacement[63], ChessPiece::Empty);
+  ASSERT_EQ(state.castlingAvailability, (CastlingAvailability{false, false, true, true}));
+  ASSERT_EQ(state.activeColor, PieceColor::Black);
+  ASSERT_EQ(state.halfmoveClock, 4);
+
+  // capturing a rook on its home square removes that side's right
+  state.makeMove(Move(0, 56));
+  ASSERT_EQ(state.castlingAvailability, (CastlingAvailability{false, false, true, false}));
+  ASSERT_EQ(state.fullmoveClock, 11);
+
+  state.unmakeMove();
+  state.unmakeMove();
+  ASSERT_EQ(state, before);
+  ASSERT_EQ(state.bitboards, before.bitboards);
+  ASSERT_THROW(state.unmakeMove(), std::out_of_range);
+}
+
+TEST(GameStateMakeMove, EnPassantAndPromotionRoundTrip)
+{
+  auto state = Game::GameState::fromFEN("4k3/1P6/8/3pP3/8/8/8/4K3 w - d6 0 1");
+  const auto before = state;
+
+  state.makeMove(Move(28, 19, MoveType::EnPassant));
+  ASSERT_EQ(state.piecePlacement[19], ChessPiece::WhitePawn);
+  ASSERT_EQ(state.piecePlacement[27], ChessPiece::Empty);
+  ASSERT_FALSE(state.enPassantIndex.has_value());
+  state.unmakeMove();
+  ASSERT_EQ(state, before);
+
+  state.makeMove(Move(9, 1, MoveType::Promotion, PieceType::Knight));
+  ASSERT_EQ(state.piecePlacement[1], ChessPiece::WhiteKnight);
+  state.unmakeMove();
+  ASSERT_EQ(state, before);
+  ASSERT_EQ(state.bitboards, before.bitboards);
+}
+
+TEST(GameStateMakeMove, ZobristKeyIsIncremental)
+{
+  auto state = Game::GameState::fromFEN("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+  const auto before = state;
+
+  state.makeMove(Move(60, 62, MoveType::Castling));
+  ASSERT_EQ(state.zobristKey, state.computeZobristKey());
+  state.makeMove(Move(0, 56));
+  ASSERT_EQ(state.zobristKey, state.computeZobristKey());
+  state.unmakeMove();
+  state.unmakeMove();
+  ASSERT_EQ(state.zobristKey, before.zobristKey);
+
+  // repeating a position restores its key; the clocks are not part of it
+  auto repeated = Game::GameState::newGameState();
+  for (int i = 0; i < 2; ++i)
+  {
+    repeated.makeMove(Move(62, 45));
+    repeated.makeMove(Move(1, 18));
+    ASSERT_EQ(repeated.zobristKey, repeated.computeZobristKey());
+    repeated.makeMove(Move(45, 62));
+    ASSERT_NE(repeated.zobristKey, Game::GameState::newGameState().zobristKey);
+    repeated.makeMove(Move(18, 1));
+  }
+  ASSERT_EQ(repeated.zobristKey, Game::GameState::newGameState().zobristKey);
+  ASSERT_EQ(repeated.zobristKey, Game::GameState::fromFEN(startingFenString).zobristKey);
+}
+
+TEST(GameStateMakeMove, HalfMoveClock)
+{
+  // a capture resets the clock, a quiet piece move advances it
+  auto state = Game::GameState::fromFEN("r1bqkbnr/pppp1ppp/2n5/4p3/3NP3/8/PPPP1PPP/RNBQKB1R b KQkq - 3 3");
+  state.makeMove(Move(18, 35));
+  ASSERT_EQ(state.halfmoveClock, 0);
+  state.unmakeMove();
+  ASSERT_EQ(state.halfmoveClock, 3);
+  state.makeMove(Move(6, 21));
+  ASSERT_EQ(state.halfmoveClock, 4);
+
+  // a pawn move resets it
+  state = Game::GameState::fromFEN("r1bqkbnr/pppppppp/8/3n1N2/8/8/PPPPPPPP/RNBQKB1R w KQkq - 6 4");
+  state.makeMove(Move(52, 44));
+  ASSERT_EQ(state.halfmoveClock, 0);
+}
+
+TEST(GameStateMakeMove, EnPassantSquare)
+{
+  // only a double pawn push leaves an en passant square
+  auto state = Game::GameState::newGameState();
+  state.makeMove(Move(52, 44));
+  ASSERT_FALSE(state.enPassantIndex.has_value());
+  state.unmakeMove();
+
+  state.makeMove(Move(52, 36));
+  ASSERT_EQ(state.enPassantIndex, Square(44));
+  state.makeMove(Move(1, 18));
+  ASSERT_FALSE(state.enPassantIndex.has_value());
+
+  state = Game::GameState::fromFEN("r1bqkbnr/ppp1pppp/n7/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3");
+  state.makeMove(Move(28, 19, MoveType::EnPassant));
+  ASSERT_EQ(state.piecePlacement[19], ChessPiece::WhitePawn);
+  ASSERT_EQ(state.piecePlacement[27], ChessPiece::Empty);
+  ASSERT_EQ(state.zobristKey, state.computeZobristKey());
+}
+
+TEST(GameStateMakeMove, PawnPromotion)
+{
+  auto white = Game::GameState::fromFEN("rnbq1bnr/pppkpPpp/8/8/8/5N2/PPpP1PPP/RNBQKB1R w KQ - 0 6");
+  const auto before = white;
+  white.makeMove(Move(13, 6, MoveType::Promotion, PieceType::Queen));
+  ASSERT_EQ(white.piecePlacement[6], ChessPiece::WhiteQueen);
+  ASSERT_EQ(white.piecePlacement[13], ChessPiece::Empty);
+  white.unmakeMove();
+  ASSERT_EQ(white, before);
+
+  auto black = Game::GameState::fromFEN("rnbq1bQr/pppkp1pp/8/8/8/5N2/PPpP1PPP/RNBQKB1R b KQ - 0 6");
+  black.makeMove(Move(50, 59, MoveType::Promotion, PieceType::Knight));
+  ASSERT_EQ(black.piecePlacement[59], ChessPiece::BlackKnight);
+  ASSERT_EQ(black.materialKey, black.computeMaterialKey());
+}
+
+TEST(GameStateMakeMove, CastlingRights)
+{
+  // a move by another piece keeps the rights, a king step drops both of its side's
+  auto white = Game::GameState::fromFEN("rn2kbnr/ppp1pppp/3qb3/3p4/8/3BPN2/PPPP1PPP/RNBQK2R w KQkq - 4 4");
+  white.makeMove(Move(43, 25));
+  ASSERT_EQ(white.castlingAvailability, (CastlingAvailability{true, true, true, true}));
+  white.unmakeMove();
+  white.makeMove(Move(60, 61));
+  ASSERT_EQ(white.castlingAvailability, (CastlingAvailability{false, false, true, true}));
+  ASSERT_EQ(white.piecePlacement[63], ChessPiece::WhiteRook);
+  white.unmakeMove();
+  white.makeMove(Move(60, 62, MoveType::Castling));
+  ASSERT_EQ(white.piecePlacement[61], ChessPiece::WhiteRook);
+  ASSERT_EQ(white.zobristKey, white.computeZobristKey());
+
+  auto black = Game::GameState::fromFEN("r3kbnr/ppp1pppp/2nqb3/3p4/8/3BPN2/PPPPQPPP/RNB2K1R b kq - 7 5");
+  black.makeMove(Move(4, 3));
+  ASSERT_EQ(black.castlingAvailability, (CastlingAvailability{false, false, false, false}));
+  ASSERT_EQ(black.piecePlacement[0], ChessPiece::BlackRook);
+  black.unmakeMove();
+  black.makeMove(Move(4, 2, MoveType::Castling));
+  ASSERT_EQ(black.piecePlacement[3], ChessPiece::BlackRook);
+  ASSERT_EQ(black.piecePlacement[0], ChessPiece::Empty);
+  ASSERT_EQ(black.zobristKey, black.computeZobristKey());
+}
+
+TEST(GameGetPieceLegalMoves, MatchesLegalTargetIndexes)
 {
   std::string fen = "rnbqkb1r/ppp2ppp/5n2/3pp3/P4P2/2P5/1P1PP1PP/RNBQKBNR w KQkq d6 0 4";
   Game startingGame(fen);
   GameTester game{startingGame};
+  const auto state = Game::GameState::fromFEN(fen);
 
-  Pawn pawn(startingGame);
-  BoardIndex pawnIndex = 28;
-  auto pawnActual = game.testGetPieceLegalMoves(pawnIndex);
-  auto pawnExpected = pawn.legalSquareIndexes(pawnIndex);
-  ASSERT_EQ(pawnActual, pawnExpected);
-
-  Knight knight(startingGame);
-  BoardIndex knightIndex = 21;
-  auto knightActual = game.testGetPieceLegalMoves(knightIndex);
-  auto knightExpected = knight.legalSquareIndexes(knightIndex);
-  ASSERT_EQ(knightActual, knightExpected);
-
-  Bishop bishop(startingGame);
-  BoardIndex bishopIndex = 2;
-  auto bishopActual = game.testGetPieceLegalMoves(bishopIndex);
-  auto bishopExpected = bishop.legalSquareIndexes(bishopIndex);
-  ASSERT_EQ(bishopActual, bishopExpected);
-
-  Rook rook(startingGame);
-  BoardIndex rookIndex = 56;
-  auto rookActual = game.testGetPieceLegalMoves(rookIndex);
-  auto rookExpected = rook.legalSquareIndexes(rookIndex);
-  ASSERT_EQ(rookActual, rookExpected);
-
-  Queen queen(startingGame);
-  BoardIndex queenIndex = 59;
-  auto queenActual = game.testGetPieceLegalMoves(queenIndex);
-  auto queenExpected = queen.legalSquareIndexes(queenIndex);
-  ASSERT_EQ(queenActual, queenExpected);
-
-  King king(startingGame);
-  BoardIndex kingIndex = 4;
-  auto kingActual = game.testGetPieceLegalMoves(kingIndex);
-  auto kingExpected = king.legalSquareIndexes(kingIndex);
-  ASSERT_EQ(kingActual, kingExpected);
+  // a pawn, knight, bishop, rook, queen and king of either side
+  for (const BoardIndex index : {28, 21, 2, 56, 59, 4})
+  {
+    ASSERT_EQ(game.testGetPieceLegalMoves(index), legalTargetIndexes(state, index)) << index;
+  }
 }
 
 TEST(GameGetPieceLegalMoves, ThrowsErrorOnEmptyPiece)
@@ -143,6 +265,23 @@ TEST(GameValidMove, ValidMove)
   ASSERT_TRUE(game.validateMove(32, 24)); // white pawn
 }
 
+TEST(GameValidMove, FollowsPlayedMoves)
+{
+  Game game;
+  GameTester gameTester(game);
+
+  ASSERT_TRUE(game.validateMove(52, 36));
+  ASSERT_EQ(game.getPieceLegalMoves(52), (std::vector<BoardIndex>{36, 44}));
+  gameTester.testMakeMove(Move(52, 36));
+
+  // the moves cached for white no longer apply once black is to move
+  ASSERT_TRUE(game.validateMove(12, 28));
+  ASSERT_FALSE(game.validateMove(12, 36));
+  gameTester.testMakeMove(Move(12, 28));
+  ASSERT_TRUE(game.getPieceLegalMoves(36).empty());
+  ASSERT_TRUE(game.validateMove(61, 25));
+}
+
 TEST(GameIsKingInCheck, KingIsNotInCheck)
 {
   Game game("rnbq1bnr/ppp1kppp/3p4/4p3/4P3/3P4/PPP1KPPP/RNBQ1BNR w - - 0 4");
@@ -167,170 +306,6 @@ TEST(GameIsKingInCheck, WhiteKingIsInCheck)
 
 // private methods
 
-TEST(GameUpdateHalfMoveClock, CaptureResetsClock)
-{
-  Game game("r1bqkbnr/pppp1ppp/2n5/4p3/3NP3/8/PPPP1PPP/RNBQKB1R b KQkq - 3 3");
-  GameTester gameTester(game);
-
-  ASSERT_TRUE(game.getHalfMoveClock() != 0);
-
-  gameTester.testUpdateHalfMoveClock(ChessPiece::WhiteKnight, ChessPiece::BlackKnight);
-
-  ASSERT_TRUE(game.getHalfMoveClock() == 0);
-}
-
-TEST(GameUpdateHalfMoveClock, PawnMoveResetsClock)
-{
-  Game game("r1bqkbnr/pppppppp/8/3n1N2/8/8/PPPPPPPP/RNBQKB1R w KQkq - 6 4");
-  GameTester gameTester(game);
-
-  ASSERT_TRUE(game.getHalfMoveClock() != 0);
-
-  gameTester.testUpdateHalfMoveClock(ChessPiece::WhitePawn, ChessPiece::Empty);
-
-  ASSERT_TRUE(game.getHalfMoveClock() == 0);
-}
-
-TEST(GameHandleEnPassant, NullBehavior)
-{
-  Game game;
-  GameTester gameTester{game};
-
-  ASSERT_FALSE(gameTester.testHandleEnPassant(52, 44));
-}
-
-TEST(GameHandleEnPassant, CreateEnPassantOpportunity)
-{
-  Game game;
-  GameTester gameTester{game};
-
-  auto isEnPassantCapture = gameTester.testHandleEnPassant(52, 36);
-
-  ASSERT_FALSE(isEnPassantCapture);
-  ASSERT_EQ(game.getEnPassantIndex(), 44);
-}
-
-TEST(GameHandleEnPassant, EnPassantCapture)
-{
-  Game game("r1bqkbnr/ppp1pppp/n7/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3");
-  GameTester gameTester{game};
-
-  auto isEnPassantCapture = gameTester.testHandleEnPassant(28, 19);
-
-  ASSERT_TRUE(isEnPassantCapture);
-  ASSERT_EQ(game.getPiecePlacement()[27], ChessPiece::Empty);
-}
-
-TEST(GameHandleEnPassant, ThrowsErrorOnEmptyPiece)
-{
-  Game game;
-  GameTester gameTester(game);
-
-  ASSERT_THROW(gameTester.testHandleEnPassant(30, 38), std::invalid_argument);
-}
-
-TEST(GameHandlePawnPromotion, PieceIsNotPawn)
-{
-  Game game("rnbq1bnr/pppkpPpp/8/8/8/5N2/PPpP1PPP/RNBQKB1R w KQ - 0 6");
-  GameTester gameTester(game);
-
-  ASSERT_EQ(gameTester.testHandlePawnPromotion(ChessPiece::WhiteKnight, 40), ChessPiece::Empty);
-  ASSERT_EQ(gameTester.testHandlePawnPromotion(ChessPiece::BlackKnight, 21), ChessPiece::Empty);
-}
-
-// No longer valid tests with pawn promotion update
-// TEST(GameHandlePawnPromotion, PawnIsNotPromotable)
-// {
-//   Game game("rnbqkbnr/ppp1pppp/4P3/8/8/3p4/PPPP1PPP/RNBQKBNR w KQkq - 0 4");
-//   GameTester gameTester(game);
-
-//   ASSERT_EQ(gameTester.testHandlePawnPromotion(ChessPiece::WhitePawn, 20), ChessPiece::Empty);
-//   ASSERT_EQ(gameTester.testHandlePawnPromotion(ChessPiece::BlackPawn, 43), ChessPiece::Empty);
-//   ASSERT_EQ(gameTester.testHandlePawnPromotion(ChessPiece::BlackPawn, 16), ChessPiece::Empty);
-// }
-
-// TEST(GameHandlePawnPromotion, WhitePawnIsPromoted)
-// {
-//   Game game("rnbq1bnr/pppkpPpp/8/8/8/5N2/PPpP1PPP/RNBQKB1R w KQ - 0 6");
-//   GameTester gameTester(game);
-
-//   const auto promotedPiece = gameTester.testHandlePawnPromotion(ChessPiece::WhitePawn, 6);
-
-//   ASSERT_EQ(promotedPiece, ChessPiece::WhiteQueen);
-//   ASSERT_EQ(game.getPiecePlacement()[6], ChessPiece::WhiteQueen);
-// }
-
-// TEST(GameHandlePawnPromotion, BlackPawnIsPromoted)
-// {
-//   Game game("rnbq1bQr/pppkp1pp/8/8/8/5N2/PPpP1PPP/RNBQKB1R b KQ - 0 6");
-//   GameTester gameTester(game);
-
-//   const auto promotedPiece = gameTester.testHandlePawnPromotion(ChessPiece::BlackPawn, 59);
-
-//   ASSERT_EQ(promotedPiece, ChessPiece::BlackQueen);
-//   ASSERT_EQ(game.getPiecePlacement()[59], ChessPiece::BlackQueen);
-// }
-
-TEST(GameHandleCastling, PieceIsNotKing)
-{
-  Game game("rn2kbnr/ppp1pppp/3qb3/3p4/8/3BPN2/PPPP1PPP/RNBQK2R w KQkq - 4 4");
-  GameTester gameTester(game);
-
-  const auto castlingResult = gameTester.testHandleCastling(43, 25);
-
-  ASSERT_TRUE(castlingResult.empty());
-}
-
-TEST(GameHandleCastling, WhiteKingIsNotCastling)
-{
-  Game game("rn2kbnr/ppp1pppp/3qb3/3p4/8/3BPN2/PPPP1PPP/RNBQK2R w KQkq - 4 4");
-  GameTester gameTester(game);
-
-  const auto castlingResult = gameTester.testHandleCastling(60, 61);
-
-  ASSERT_TRUE(castlingResult.empty());
-}
-
-TEST(GameHandleCastling, BlackKingIsNotCastling)
-{
-  Game game("r3kbnr/ppp1pppp/2nqb3/3p4/8/3BPN2/PPPPQPPP/RNB2K1R b kq - 7 5");
-  GameTester gameTester(game);
-
-  const auto castlingResult = gameTester.testHandleCastling(4, 3);
-
-  ASSERT_TRUE(castlingResult.empty());
-}
-
-TEST(GameHandleCastling, WhiteKingCastle)
-{
-  Game game("rn2kbnr/ppp1pppp/3qb3/3p4/8/3BPN2/PPPP1PPP/RNBQK2R w KQkq - 4 4");
-  GameTester gameTester(game);
-
-  const auto castlingResult = gameTester.testHandleCastling(60, 62);
-
-  ASSERT_EQ(castlingResult, shortCastleString);
-  ASSERT_EQ(game.getPiecePlacement()[61], ChessPiece::WhiteRook);
-}
-
-TEST(GameHandleCastling, BlackKingCastle)
-{
-  Game game("r3kbnr/ppp1pppp/2nqb3/3p4/8/3BPN2/PPPPQPPP/RNB2K1R b kq - 7 5");
-  GameTester gameTester(game);
-
-  const auto castlingResult = gameTester.testHandleCastling(4, 2);
-
-  ASSERT_EQ(castlingResult, longCastleString);
-  ASSERT_EQ(game.getPiecePlacement()[3], ChessPiece::BlackRook);
-}
-
-TEST(GameHandleCastling, ThrowsErrorOnEmptyPiece)
-{
-  Game game("r3kbnr/ppp1pppp/2nqb3/3p4/8/3BPN2/PPPPQPPP/RNB2K1R b kq - 7 5");
-  GameTester gameTester(game);
-
-  ASSERT_THROW(gameTester.testHandleCastling(3, 2), std::invalid_argument);
-}
-
 TEST(GameHandleGameOver, IsNotGameover)
 {
   Game game1;
@@ -393,7 +368,48 @@ TEST(GameHandleGameOver, FiftyMoveRule)
   ASSERT_TRUE(gameTester.testHandleGameOver());
 }
 
-// Repetition test
+TEST(GameHandleGameOver, ThreefoldRepetition)
+{
+  Game game;
+  GameTester gameTester(game);
+
+  // knights out and back twice brings the starting position back for the third time
+  for (int i = 0; i < 2; ++i)
+  {
+    ASSERT_FALSE(gameTester.testHandleGameOver());
+    gameTester.testMakeMove(Move(62, 45));
+    gameTester.testMakeMove(Move(1, 18));
+    gameTester.testMakeMove(Move(45, 62));
+    gameTester.testMakeMove(Move(18, 1));
+  }
+  ASSERT_TRUE(gameTester.testHandleGameOver());
+  ASSERT_EQ(game.message, "draw by repetition");
+}
+
+TEST(GameStateRepetition, ComparesEarlierPositionsOfSameSide)
+{
+  auto state = Game::GameState::newGameState();
+  const auto shuffleKnights = [&]()
+  {
+    state.makeMove(Move(62, 45));
+    state.makeMove(Move(1, 18));
+    state.makeMove(Move(45, 62));
+    state.makeMove(Move(18, 1));
+  };
+
+  shuffleKnights();
+  ASSERT_FALSE(state.isThreefoldRepetition());
+  shuffleKnights();
+  ASSERT_TRUE(state.isThreefoldRepetition());
+  state.unmakeMove();
+  ASSERT_FALSE(state.isThreefoldRepetition());
+
+  // the clock may count moves from before the FEN that are not in history
+  state = Game::GameState::fromFEN("4k3/8/8/8/8/8/4P3/4K3 w - - 40 60");
+  state.makeMove(Move(60, 59));
+  state.makeMove(Move(4, 3));
+  ASSERT_FALSE(state.isThreefoldRepetition());
+}
 
 TEST(GameHandleGameOver, KingVersusKingIsDraw)
 {
@@ -442,154 +458,6 @@ TEST(GameHanldeGameOver, KingMinorPieceVersusKingMinorPiece)
   ASSERT_TRUE(gameWithKnightBishopTester.testHandleGameOver());
 }
 
-TEST(GameIncrementPositionCount, UpdatesStartingPositionCount)
-{
-  Game game;
-  GameTester gameTester(game);
-  Position startingPos{game.getPiecePlacement(), game.getCastlingAvailability(), game.getEnPassantIndex()};
-  game.positionCount = {{startingPos, 1}}; // in test env, starting position has count 2 after initialization
-
-  gameTester.testIncrementPositionCount();
-
-  ASSERT_TRUE(game.positionCount[startingPos] == 2);
-}
-
-TEST(GameGetSamePieceIndexes, WhiteKnight)
-{
-  Game game("1nbqkbn1/1ppp1pp1/r6r/p3p2p/4P3/1N1P4/PPP2PPP/RNBQKB1R w KQ - 1 6");
-  GameTester gameTester(game);
-  std::vector<BoardIndex> expected, actual;
-
-  // white knights
-  actual = gameTester.testGetSamePieceIndexes(57, 51);
-  expected = {41};
-  ASSERT_EQ(actual, expected);
-
-  actual = gameTester.testGetSamePieceIndexes(41, 51);
-  expected = {57};
-  ASSERT_EQ(actual, expected);
-
-  // black rooks
-  actual = gameTester.testGetSamePieceIndexes(16, 19);
-  expected = {23};
-  ASSERT_EQ(actual, expected);
-
-  actual = gameTester.testGetSamePieceIndexes(23, 19);
-  expected = {16};
-  ASSERT_EQ(actual, expected);
-
-  // white pawn
-  actual = gameTester.testGetSamePieceIndexes(43, 35);
-  expected = {};
-  ASSERT_EQ(actual, expected);
-}
-
-TEST(GameIsSquareUnderAttack, Pawns)
-{
-  Game game("rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 2");
-  GameTester gameTester(game);
-  const auto piecePlacement = game.getPiecePlacement();
-
-  // white defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(33, PieceColor::White, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(34, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(35, PieceColor::White, piecePlacement));
-
-  // black defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(27, PieceColor::Black, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(28, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(29, PieceColor::Black, piecePlacement));
-}
-
-TEST(GameIsSquareUnderAttack, Knights)
-{
-  Game game("r1bqkbnr/pppppppp/2n5/8/8/5N2/PPPPPPPP/RNBQKB1R w KQkq - 2 2");
-  GameTester gameTester(game);
-  const auto piecePlacement = game.getPiecePlacement();
-
-  // white defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(35, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(28, PieceColor::White, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(36, PieceColor::White, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(27, PieceColor::White, piecePlacement));
-
-  // black defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(35, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(28, PieceColor::Black, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(36, PieceColor::Black, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(27, PieceColor::Black, piecePlacement));
-}
-
-TEST(GameIsSquareUnderAttack, Bishops)
-{
-  Game game("rn1qkbnr/ppp1pppp/3pb3/8/8/3BP3/PPPP1PPP/RNBQK1NR w KQkq - 2 3");
-  GameTester gameTester(game);
-  const auto piecePlacement = game.getPiecePlacement();
-
-  // white defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(27, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(48, PieceColor::White, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(36, PieceColor::White, piecePlacement));
-
-  // black defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(36, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(15, PieceColor::Black, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(28, PieceColor::Black, piecePlacement));
-}
-
-TEST(GameIsSquareUnderAttack, Rooks)
-{
-  Game game("1nbqkbnr/1ppppppp/8/r6P/p6R/8/PPPPPPP1/RNBQKBN1 w Qk - 2 5");
-  GameTester gameTester(game);
-  const auto piecePlacement = game.getPiecePlacement();
-
-  // white defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(26, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(29, PieceColor::White, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(33, PieceColor::White, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(34, PieceColor::White, piecePlacement));
-
-  // black defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(34, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(37, PieceColor::Black, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(29, PieceColor::Black, piecePlacement));
-  ASSERT_FALSE(gameTester.testIsSquareUnderAttack(30, PieceColor::Black, piecePlacement));
-}
-
-TEST(GameIsSquareUnderAttack, Queens)
-{
-  Game game("rnb1kbnr/pppp1ppp/4p3/7Q/7q/4P3/PPPP1PPP/RNB1KBNR w KQkq - 2 3");
-  GameTester gameTester(game);
-  const auto piecePlacement = game.getPiecePlacement();
-
-  // white defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(31, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(53, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(3, PieceColor::White, piecePlacement));
-
-  // black defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(39, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(13, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(59, PieceColor::Black, piecePlacement));
-}
-
-TEST(GameIsSquareUnderAttack, Kings)
-{
-  Game game("rnbq1bnr/pppp1ppp/8/2k1p3/4P1K1/8/PPPP1PPP/RNBQ1BNR w - - 6 5");
-  GameTester gameTester(game);
-  const auto piecePlacement = game.getPiecePlacement();
-
-  // white defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(17, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(19, PieceColor::White, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(34, PieceColor::White, piecePlacement));
-
-  // black defending
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(45, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(47, PieceColor::Black, piecePlacement));
-  ASSERT_TRUE(gameTester.testIsSquareUnderAttack(30, PieceColor::Black, piecePlacement));
-}
-
 // check
 
 TEST(PawnCheck, BlackInCheck)
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "../src/gameState.hpp"
+#include "../src/material.hpp"
+#include "../src/move.hpp"
+#include "../src/types.hpp"
+
+TEST(MaterialKeyTest, CountsPieces)
+{
+  const auto key = GameState::newGameState().materialKey;
+
+  ASSERT_EQ(pieceCount(key, PieceColor::White, PieceType::Pawn), 8);
+  ASSERT_EQ(pieceCount(key, PieceColor::Black, PieceType::Knight), 2);
+  ASSERT_EQ(pieceCount(key, PieceColor::Black, PieceType::Queen), 1);
+  ASSERT_EQ(pieceCount(key, PieceColor::White, PieceType::King), 1);
+}
+
+TEST(MaterialKeyTest, FollowsMakeAndUnmake)
+{
+  // b7 takes a8 and promotes to a queen
+  auto state = GameState::fromFEN("r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1");
+  const auto before = state.materialKey;
+
+  state.makeMove(Move(9, 0, MoveType::Promotion, PieceType::Queen));
+  ASSERT_EQ(state.materialKey, state.computeMaterialKey());
+  ASSERT_EQ(pieceCount(state.materialKey, PieceColor::White, PieceType::Pawn), 0);
+  ASSERT_EQ(pieceCount(state.materialKey, PieceColor::White, PieceType::Queen), 1);
+  ASSERT_EQ(pieceCount(state.materialKey, PieceColor::Black, PieceType::Rook), 0);
+
+  state.unmakeMove();
+  ASSERT_EQ(state.materialKey, before);
+}
+
+TEST(MaterialKeyTest, RejectsCountsThatOverflowANibble)
+{
+  // sixteen queens, and nine pawns, for white
+  ASSERT_THROW(GameState::fromFEN("QQQQQQQQ/QQQQQQQQ/8/8/8/8/7k/K7 w - - 0 1"), std::invalid_argument);
+  ASSERT_THROW(GameState::fromFEN("4k3/8/8/8/8/P7/PPPPPPPP/4K3 w - - 0 1"), std::invalid_argument);
+
+  // fifteen queens are a legal setup and still fit
+  const auto key = GameState::fromFEN("QQQQQQQQ/QQQQQQQ1/8/8/8/8/7k/K7 w - - 0 1").materialKey;
+  ASSERT_EQ(pieceCount(key, PieceColor::White, PieceType::Queen), 15);
+  ASSERT_EQ(pieceCount(key, PieceColor::White, PieceType::King), 1);
+}
+
+TEST(MaterialKeyTest, InsufficientMaterial)
+{
+  const auto keyOf = [](const char *fen) { return GameState::fromFEN(fen).materialKey; };
+
+  ASSERT_TRUE(isInsufficientMaterial(keyOf("4k3/8/8/8/8/8/8/4K3 w - - 0 1")));
+  ASSERT_TRUE(isInsufficientMaterial(keyOf("4k3/8/8/8/8/8/8/1N2K1N1 w - - 0 1")));
+  ASSERT_TRUE(isInsufficientMaterial(keyOf("4kb2/8/8/8/8/8/8/1N2K3 w - - 0 1")));
+  ASSERT_FALSE(isInsufficientMaterial(keyOf("4k3/8/8/8/8/8/8/2B1KB2 w - - 0 1")));
+  ASSERT_FALSE(isInsufficientMaterial(keyOf("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1")));
+
+  // two knights cannot force mate, two bishops or bishop and knight can
+  const auto key = keyOf("4k3/8/8/8/8/8/8/1N2K1N1 w - - 0 1");
+  ASSERT_FALSE(canCheckmate(key, PieceColor::White));
+  ASSERT_FALSE(canCheckmate(key, PieceColor::Black));
+  ASSERT_TRUE(canCheckmate(keyOf("4k3/8/8/8/8/8/8/2B1KB2 w - - 0 1"), PieceColor::White));
+  ASSERT_TRUE(canCheckmate(keyOf("4k3/8/8/8/8/8/8/2N1KB2 w - - 0 1"), PieceColor::White));
+}
@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/gameState.hpp"
+#include "../src/move.hpp"
+#include "../src/movegen.hpp"
+#include "../src/types.hpp"
+#include "../src/utils.hpp"
+
+TEST(MoveTest, Encoding)
+{
+  const Move move(12, 4, MoveType::Promotion, PieceType::Queen);
+  ASSERT_EQ(move.fromIndex(), 12);
+  ASSERT_EQ(move.toIndex(), 4);
+  ASSERT_EQ(move.type(), MoveType::Promotion);
+  ASSERT_EQ(move.promotionType(), PieceType::Queen);
+
+  ASSERT_EQ(Move(60, 62, MoveType::Castling).type(), MoveType::Castling);
+  ASSERT_NE(Move(12, 4, MoveType::Promotion, PieceType::Rook), move);
+}
+
+TEST(GenerateLegalMovesTest, StartingPosition)
+{
+  MoveList moves;
+  generateLegalMoves(GameState::newGameState(), moves);
+
+  ASSERT_EQ(moves.size(), 20);
+}
+
+TEST(GenerateLegalMovesTest, SpecialMoves)
+{
+  // white can castle both ways, take en passant on d6 and promote on a8 or capture-promote on b8
+  const auto state = GameState::fromFEN("1n2k3/P7/8/3pP3/8/8/8/R3K2R w KQ d6 0 1");
+  MoveList moves;
+  generateLegalMoves(state, moves);
+
+  ASSERT_TRUE(moves.contains(Move(60, 62, MoveType::Castling)));
+  ASSERT_TRUE(moves.contains(Move(60, 58, MoveType::Castling)));
+  ASSERT_TRUE(moves.contains(Move(28, 19, MoveType::EnPassant)));
+  ASSERT_TRUE(moves.contains(Move(8, 0, MoveType::Promotion, PieceType::Knight)));
+  ASSERT_TRUE(moves.contains(Move(8, 1, MoveType::Promotion, PieceType::Queen)));
+}
+
+TEST(GenerateLegalMovesTest, CheckLimitsMoves)
+{
+  // only the king can move out of the rook's check, and castling is not allowed while in check
+  const auto state = GameState::fromFEN("4r1k1/8/8/8/8/8/P7/R3K3 w Q - 0 1");
+  MoveList moves;
+  generateLegalMoves(state, moves);
+
+  ASSERT_EQ(moves.size(), 4);
+  for (const auto move : moves)
+  {
+    ASSERT_EQ(move.fromIndex(), 60);
+    ASSERT_NE(move.type(), MoveType::Castling);
+  }
+}
+
+TEST(GenerateLegalMovesTest, PinnedPieces)
+{
+  // the c3 rook is pinned diagonally and cannot move, and taking en passant would clear the fifth rank
+  // between the king and the h5 rook
+  const auto state = GameState::fromFEN("6k1/8/8/K2pP2r/8/2R5/8/4b3 w - d6 0 1");
+  MoveList moves;
+  generateLegalMoves(state, moves);
+
+  ASSERT_TRUE(moves.contains(Move(28, 20)));
+  ASSERT_FALSE(moves.contains(Move(28, 19, MoveType::EnPassant)));
+  for (const auto move : moves)
+  {
+    ASSERT_NE(move.fromIndex(), 42);
+  }
+}
+
+TEST(GenerateMovesTest, StagesPartitionLegalMoves)
+{
+  const auto state = GameState::fromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  MoveList legal, captures, quiets, evasions;
+  generateLegalMoves(state, legal);
+  generateMoves<GenType::Captures>(state, captures);
+  generateMoves<GenType::Quiets>(state, quiets);
+  generateMoves<GenType::Evasions>(state, evasions);
+
+  ASSERT_EQ(legal.size(), 48);
+  ASSERT_EQ(captures.size(), 8);
+  ASSERT_EQ(captures.size() + quiets.size(), legal.size());
+  for (const auto move : captures)
+  {
+    ASSERT_TRUE(legal.contains(move));
+    ASSERT_FALSE(quiets.contains(move));
+  }
+  ASSERT_TRUE(evasions.empty());
+}
+
+TEST(GenerateMovesTest, EvasionsAndQuietChecks)
+{
+  const auto inCheck = GameState::fromFEN("4r1k1/8/8/8/8/8/P7/R3K3 w Q - 0 1");
+  MoveList legal, evasions;
+  generateLegalMoves(inCheck, legal);
+  generateMoves<GenType::Evasions>(inCheck, evasions);
+  ASSERT_EQ(evasions.size(), legal.size());
+
+  // only the rook can check, from d8 along the back rank or from g1 up the g-file
+  const auto state = GameState::fromFEN("6k1/8/8/8/8/8/8/K2R4 w - - 0 1");
+  MoveList quietChecks;
+  generateMoves<GenType::QuietChecks>(state, quietChecks);
+  ASSERT_EQ(quietChecks.size(), 2);
+  ASSERT_TRUE(quietChecks.contains(Move(59, 3)));
+  ASSERT_TRUE(quietChecks.contains(Move(59, 62)));
+}
+
+TEST(GenerateMovesTest, QuietChecksMatchFilteredQuiets)
+{
+  // discovered checks by pawn, bishop and king, and castling into check
+  const std::vector<std::string> fens = {
+      "5k2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+      "3k4/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+      "8/8/3k4/8/8/3P4/3B4/3QK3 w - - 0 1",
+      "7k/8/8/8/3P4/8/1B6/K7 w - - 0 1",
+      "3r3k/8/8/3n4/8/8/8/3K4 b - - 0 1",
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+  };
+
+  for (const auto &fen : fens)
+  {
+    const auto state = GameState::fromFEN(fen);
+    MoveList quiets, quietChecks;
+    generateMoves<GenType::Quiets>(state, quiets);
+    generateMoves<GenType::QuietChecks>(state, quietChecks);
+
+    const auto expected = std::count_if(
+        quiets.begin(), quiets.end(), [&](const Move move) { return givesCheck(state, move); });
+    ASSERT_EQ(quietChecks.size(), static_cast<size_t>(expected)) << fen;
+    for (const auto move : quietChecks)
+    {
+      ASSERT_TRUE(quiets.contains(move)) << fen;
+      ASSERT_TRUE(givesCheck(state, move)) << fen;
+    }
+  }
+}
+
+TEST(IsLegalTest, MatchesGeneratedMoves)
+{
+  const auto state = GameState::fromFEN("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+  MoveList moves;
+  generateLegalMoves(state, moves);
+
+  for (int fromIndex = 0; fromIndex < 64; ++fromIndex)
+  {
+    if (state.piecePlacement[fromIndex] == ChessPiece::Empty)
+    {
+      continue;
+    }
+    if (getPieceColor(state.piecePlacement[fromIndex]) != state.activeColor)
+    {
+      continue;
+    }
+
+    for (int toIndex = 0; toIndex < 64; ++toIndex)
+    {
+      const bool isGenerated = std::any_of(
+          moves.begin(),
+          moves.end(),
+          [&](const Move move) { return move.fromIndex() == fromIndex && move.toIndex() == toIndex; });
+      ASSERT_EQ(isLegal(state, fromIndex, toIndex), isGenerated) << fromIndex << " -> " << toIndex;
+    }
+  }
+
+  ASSERT_FALSE(isLegal(state, 44, 36)); // no piece on e3
+}
+
+TEST(AnyLegalMoveTest, MatesStalematesAndLastMoves)
+{
+  ASSERT_TRUE(anyLegalMove(GameState::newGameState()));
+  ASSERT_FALSE(anyLegalMove(GameState::fromFEN("3n4/r2P2q1/kQ6/7r/p2B4/P4R2/3K4/5R2 b - - 0 1"))); // mate
+  ASSERT_FALSE(anyLegalMove(GameState::fromFEN("8/8/p1k5/P7/8/4q3/q7/3K4 w - - 0 1")));          // stalemate
+
+  // the king is boxed in and taking the checking pawn en passant is the only move
+  const auto state = GameState::fromFEN("k7/5b2/5p2/4nPp1/7K/4q3/8/8 w - g6 0 2");
+  MoveList moves;
+  generateLegalMoves(state, moves);
+  ASSERT_EQ(moves.size(), 1);
+  ASSERT_TRUE(anyLegalMove(state));
+}
+
+TEST(AmbiguousMoversTest, FiltersPinnedPieces)
+{
+  // both rooks see c5, but the c2 rook is pinned against its king by the e4 bishop
+  const auto pinned = GameState::fromFEN("2R1k3/8/8/8/4b3/8/2R5/1K6 w - - 0 1");
+  ASSERT_EQ(ambiguousMovers(pinned, 2, 26), 0);
+
+  const auto free = GameState::fromFEN("2R1k3/8/8/8/8/8/2R5/1K6 w - - 0 1");
+  ASSERT_EQ(ambiguousMovers(free, 2, 26), squareBitboard(50));
+  ASSERT_EQ(ambiguousMovers(free, 50, 26), squareBitboard(2));
+
+  // pawn captures always name their file, so the second pawn able to take on d5 is not reported
+  const auto pawns = GameState::fromFEN("4k3/8/8/3p4/2P1P3/8/8/4K3 w - - 0 1");
+  ASSERT_EQ(ambiguousMovers(pawns, 36, 27), 0);
+}
+
+TEST(AmbiguousMoversTest, KnightsRooksAndPawns)
+{
+  const auto state = GameState::fromFEN("1nbqkbn1/1ppp1pp1/r6r/p3p2p/4P3/1N1P4/PPP2PPP/RNBQKB1R w KQ - 1 6");
+
+  // white knights
+  ASSERT_EQ(ambiguousMovers(state, 57, 51), squareBitboard(41));
+  ASSERT_EQ(ambiguousMovers(state, 41, 51), squareBitboard(57));
+
+  // black rooks
+  ASSERT_EQ(ambiguousMovers(state, 16, 19), squareBitboard(23));
+  ASSERT_EQ(ambiguousMovers(state, 23, 19), squareBitboard(16));
+
+  // white pawn
+  ASSERT_EQ(ambiguousMovers(state, 43, 35), 0);
+}
+
+TEST(IsSquareAttackedTest, Pawns)
+{
+  const auto bitboards = GameState::fromFEN("rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 2").bitboards;
+
+  // white defending
+  ASSERT_TRUE(isSquareAttacked(33, PieceColor::White, bitboards));
+  ASSERT_FALSE(isSquareAttacked(34, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(35, PieceColor::White, bitboards));
+
+  // black defending
+  ASSERT_TRUE(isSquareAttacked(27, PieceColor::Black, bitboards));
+  ASSERT_FALSE(isSquareAttacked(28, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(29, PieceColor::Black, bitboards));
+}
+
+TEST(IsSquareAttackedTest, Knights)
+{
+  const auto bitboards = GameState::fromFEN("r1bqkbnr/pppppppp/2n5/8/8/5N2/PPPPPPPP/RNBQKB1R w KQkq - 2 2").bitboards;
+
+  // white defending
+  ASSERT_TRUE(isSquareAttacked(35, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(28, PieceColor::White, bitboards));
+  ASSERT_FALSE(isSquareAttacked(36, PieceColor::White, bitboards));
+  ASSERT_FALSE(isSquareAttacked(27, PieceColor::White, bitboards));
+
+  // black defending
+  ASSERT_TRUE(isSquareAttacked(35, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(28, PieceColor::Black, bitboards));
+  ASSERT_FALSE(isSquareAttacked(36, PieceColor::Black, bitboards));
+  ASSERT_FALSE(isSquareAttacked(27, PieceColor::Black, bitboards));
+}
+
+TEST(IsSquareAttackedTest, Bishops)
+{
+  const auto bitboards = GameState::fromFEN("rn1qkbnr/ppp1pppp/3pb3/8/8/3BP3/PPPP1PPP/RNBQK1NR w KQkq - 2 3").bitboards;
+
+  // white defending
+  ASSERT_TRUE(isSquareAttacked(27, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(48, PieceColor::White, bitboards));
+  ASSERT_FALSE(isSquareAttacked(36, PieceColor::White, bitboards));
+
+  // black defending
+  ASSERT_TRUE(isSquareAttacked(36, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(15, PieceColor::Black, bitboards));
+  ASSERT_FALSE(isSquareAttacked(28, PieceColor::Black, bitboards));
+}
+
+TEST(IsSquareAttackedTest, Rooks)
+{
+  const auto bitboards = GameState::fromFEN("1nbqkbnr/1ppppppp/8/r6P/p6R/8/PPPPPPP1/RNBQKBN1 w Qk - 2 5").bitboards;
+
+  // white defending
+  ASSERT_TRUE(isSquareAttacked(26, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(29, PieceColor::White, bitboards));
+  ASSERT_FALSE(isSquareAttacked(33, PieceColor::White, bitboards));
+  ASSERT_FALSE(isSquareAttacked(34, PieceColor::White, bitboards));
+
+  // black defending
+  ASSERT_TRUE(isSquareAttacked(34, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(37, PieceColor::Black, bitboards));
+  ASSERT_FALSE(isSquareAttacked(29, PieceColor::Black, bitboards));
+  ASSERT_FALSE(isSquareAttacked(30, PieceColor::Black, bitboards));
+}
+
+TEST(IsSquareAttackedTest, Queens)
+{
+  const auto bitboards = GameState::fromFEN("rnb1kbnr/pppp1ppp/4p3/7Q/7q/4P3/PPPP1PPP/RNB1KBNR w KQkq - 2 3").bitboards;
+
+  // white defending
+  ASSERT_TRUE(isSquareAttacked(31, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(53, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(3, PieceColor::White, bitboards));
+
+  // black defending
+  ASSERT_TRUE(isSquareAttacked(39, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(13, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(59, PieceColor::Black, bitboards));
+}
+
+TEST(IsSquareAttackedTest, Kings)
+{
+  const auto bitboards = GameState::fromFEN("rnbq1bnr/pppp1ppp/8/2k1p3/4P1K1/8/PPPP1PPP/RNBQ1BNR w - - 6 5").bitboards;
+
+  // white defending
+  ASSERT_TRUE(isSquareAttacked(17, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(19, PieceColor::White, bitboards));
+  ASSERT_TRUE(isSquareAttacked(34, PieceColor::White, bitboards));
+
+  // black defending
+  ASSERT_TRUE(isSquareAttacked(45, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(47, PieceColor::Black, bitboards));
+  ASSERT_TRUE(isSquareAttacked(30, PieceColor::Black, bitboards));
+}
+
+TEST(GeneratePieceMovesTest, ThrowsOnEmptySquare)
+{
+  const auto state = GameState::newGameState();
+  MoveList moves;
+
+  ASSERT_THROW(generatePieceMoves(state, 36, moves), std::invalid_argument);
+  ASSERT_TRUE(moves.empty());
+  ASSERT_THROW(legalTargetIndexes(state, 36), std::invalid_argument);
+  ASSERT_EQ(legalTargetIndexes(state, 52), (std::vector<BoardIndex>{36, 44}));
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "../src/gameState.hpp"
+#include "../src/move.hpp"
+#include "../src/packedState.hpp"
+
+TEST(PackedStateTest, RoundTrip)
+{
+  for (const std::string fen :
+       {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1",
+        "4k3/8/8/8/8/8/8/4K3 b - - 99 300"})
+  {
+    const auto state = GameState::fromFEN(fen);
+    const auto unpacked = PackedState::fromGameState(state).toGameState();
+
+    ASSERT_EQ(unpacked, state) << fen;
+    ASSERT_EQ(unpacked.bitboards, state.bitboards) << fen;
+    ASSERT_EQ(unpacked.zobristKey, state.zobristKey) << fen;
+  }
+}
+
+TEST(PackedStateTest, EqualPositionsEncodeEqually)
+{
+  auto state = GameState::newGameState();
+  const auto before = PackedState::fromGameState(state);
+
+  state.makeMove(Move(62, 45));
+  ASSERT_FALSE(PackedState::fromGameState(state) == before);
+  state.unmakeMove();
+  const auto after = PackedState::fromGameState(state);
+  ASSERT_EQ(after, before);
+  ASSERT_EQ(std::memcmp(&after, &before, sizeof(PackedState)), 0);
+}
+
+TEST(PackedStateTest, RejectsClocksBeyondSixteenBits)
+{
+  auto state = GameState::newGameState();
+  state.halfmoveClock = UINT16_MAX + 1;
+  ASSERT_THROW(PackedState::fromGameState(state), std::invalid_argument);
+
+  state.halfmoveClock = 0;
+  state.fullmoveClock = UINT16_MAX + 1;
+  ASSERT_THROW(PackedState::fromGameState(state), std::invalid_argument);
+}
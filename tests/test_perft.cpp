@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../src/gameState.hpp"
+#include "../src/perft.hpp"
+
+struct PerftCase
+{
+  std::string fen;
+  int depth;
+  uint64_t nodes;
+};
+
+// runs every case from scratch and records the combined speed, so speed regressions show up in the test report
+static void checkPerft(const std::vector<PerftCase> &cases)
+{
+  uint64_t totalNodes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto &perftCase : cases)
+  {
+    SCOPED_TRACE(perftCase.fen);
+    auto state = GameState::fromFEN(perftCase.fen);
+    ASSERT_EQ(perft(state, perftCase.depth), perftCase.nodes);
+    ASSERT_EQ(state, GameState::fromFEN(perftCase.fen));
+    totalNodes += perftCase.nodes;
+  }
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  testing::Test::RecordProperty("nodes", std::to_string(totalNodes));
+  testing::Test::RecordProperty("nps", std::to_string(static_cast<uint64_t>(elapsed > 0 ? totalNodes / elapsed : 0)));
+}
+
+TEST(PerftTest, StandardPositions)
+{
+  checkPerft({
+      {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 197281},
+      {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862},
+      {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624},
+      {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333},
+      {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+      {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3, 89890},
+  });
+}
+
+TEST(PerftTest, EnPassant)
+{
+  checkPerft({
+      // taking en passant would expose the king along the rank
+      {"3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 5, 185429},
+      {"8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 5, 135655},
+      // the en passant capture itself gives check
+      {"8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 5, 206379},
+  });
+}
+
+TEST(PerftTest, Castling)
+{
+  checkPerft({
+      // castling gives check
+      {"5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072},
+      {"3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711},
+      // rights are lost when rooks are captured, and castling through or out of check is not allowed
+      {"r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206},
+      {"r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476},
+  });
+}
+
+TEST(PerftTest, PromotionsAndChecks)
+{
+  checkPerft({
+      {"2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 5, 266199},
+      {"8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 1004658},
+      {"4k3/1P6/8/8/8/8/K7/8 w - - 0 1", 6, 217342},
+      {"8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, 92683},
+      {"K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217},
+      {"8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, 567584},
+      {"8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527},
+  });
+}
+
+TEST(PerftTest, DivideWithThreadsAndTable)
+{
+  const auto state =
+      GameState::fromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  PerftTable table(1);
+
+  uint64_t nodes = 0;
+  const auto divide = perftDivide(state, 4, 4, &table);
+  for (const auto &[move, count] : divide)
+  {
+    nodes += count;
+  }
+
+  ASSERT_EQ(divide.size(), 48);
+  ASSERT_EQ(nodes, 4085603);
+}
@@ -62,7 +62,34 @@ TEST(PieceColorTest, ValidInput)
   ASSERT_EQ(getPieceColor(ChessPiece::WhiteKing), PieceColor::White);
 }
 
-TEST(PieceColorTest, InvalidInput) { ASSERT_THROW(getPieceColor(ChessPiece::Empty), std::invalid_argument); }
+TEST(PieceColorTest, InvalidInput)
+{
+  ASSERT_THROW(getPieceColor(ChessPiece::Empty), std::invalid_argument);
+  ASSERT_THROW(getPieceType(ChessPiece::Empty), std::invalid_argument);
+}
+
+TEST(PieceTraitsTest, MatchesPieceChars)
+{
+  static_assert(getPieceColor(ChessPiece::BlackKnight) == PieceColor::Black);
+  static_assert(getPieceType(ChessPiece::WhiteQueen) == PieceType::Queen);
+  static_assert(makeChessPiece(PieceColor::Black, PieceType::Rook) == ChessPiece::BlackRook);
+
+  int pieceCount = 0;
+  for (int c = 0; c < 256; ++c)
+  {
+    if (!isChessPiece(static_cast<char>(c)))
+    {
+      continue;
+    }
+
+    ++pieceCount;
+    const auto piece = charToChessPiece(static_cast<char>(c));
+    ASSERT_EQ(chessPieceToChar(piece), static_cast<char>(c));
+    ASSERT_EQ(makeChessPiece(getPieceColor(piece), getPieceType(piece)), piece);
+  }
+  ASSERT_EQ(pieceCount, 12);
+  ASSERT_FALSE(isChessPiece('\0'));
+}
 
 TEST(AlgebraicToIndexTest, ValidInput)
 {